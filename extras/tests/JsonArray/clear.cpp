@@ -22,4 +22,34 @@ TEST_CASE("JsonArray::clear()") {
     REQUIRE(array.size() == 0);
     REQUIRE(array.isNull() == false);
   }
+
+  SECTION("Recycles the slots of the nested elements") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(4)> doc;
+    JsonArray array = doc.to<JsonArray>();
+    JsonArray nested = array.createNestedArray();
+    nested.add(1);
+    nested.add(2);
+    array.clear();
+
+    array.add(3);
+    array.add(4);
+    array.add(5);
+
+    REQUIRE(doc.overflowed() == false);
+    REQUIRE(doc.as<std::string>() == "[3,4,5]");
+  }
+
+  SECTION("In a loop") {
+    StaticJsonDocument<JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(3)> doc;
+    JsonArray array = doc.createNestedArray("values");
+
+    for (int i = 0; i < 100; i++) {
+      array.clear();
+      array.add(i);
+      array.createNestedArray().add(i + 1);
+    }
+
+    REQUIRE(doc.overflowed() == false);
+    REQUIRE(doc.as<std::string>() == "{\"values\":[99,[100]]}");
+  }
 }
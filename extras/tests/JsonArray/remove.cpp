@@ -77,6 +77,22 @@ TEST_CASE("JsonArray::remove()") {
     REQUIRE(array[1] == 3);
   }
 
+  SECTION("In a loop, with consecutive matches") {
+    array.clear();
+    array.add(2);
+    array.add(2);
+    array.add(3);
+    array.add(2);
+    array.add(2);
+
+    for (JsonArray::iterator it = array.begin(); it != array.end(); ++it) {
+      if (*it == 2)
+        array.remove(it);
+    }
+
+    REQUIRE(doc.as<std::string>() == "[3]");
+  }
+
   SECTION("remove by index on unbound reference") {
     JsonArray unboundArray;
     unboundArray.remove(20);
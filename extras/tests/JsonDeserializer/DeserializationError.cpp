@@ -37,6 +37,9 @@ TEST_CASE("DeserializationError") {
     TEST_STRINGIFICATION(InvalidInput);
     TEST_STRINGIFICATION(NoMemory);
     TEST_STRINGIFICATION(TooDeep);
+    TEST_STRINGIFICATION(NeedMoreData);
+    TEST_STRINGIFICATION(InvalidUtf8);
+    TEST_STRINGIFICATION(StringTooLong);
   }
 
   SECTION("as boolean") {
@@ -46,6 +49,9 @@ TEST_CASE("DeserializationError") {
     TEST_BOOLIFICATION(InvalidInput, true);
     TEST_BOOLIFICATION(NoMemory, true);
     TEST_BOOLIFICATION(TooDeep, true);
+    TEST_BOOLIFICATION(NeedMoreData, true);
+    TEST_BOOLIFICATION(InvalidUtf8, true);
+    TEST_BOOLIFICATION(StringTooLong, true);
   }
 
   SECTION("ostream DeserializationError") {
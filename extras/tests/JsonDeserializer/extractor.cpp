@@ -0,0 +1,149 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+TEST_CASE("JsonExtractor") {
+  StaticJsonDocument<256> doc;
+  JsonExtractor<16> extractor;
+
+  SECTION("JSON Pointers and dotted paths") {
+    int id = 0;
+    double temp = 0;
+    JsonString name;
+    int second = 0;
+    REQUIRE(extractor.add("/sensor/id", id));
+    REQUIRE(extractor.add("sensor.temp", temp));
+    REQUIRE(extractor.add("/name", name));
+    REQUIRE(extractor.add("values.1", second));
+
+    DeserializationError err = extractor.extract(
+        doc,
+        "{\"name\":\"gps\",\"skipped\":{\"a\":[1,2,3]},"
+        "\"sensor\":{\"temp\":21.5,\"id\":42},\"values\":[10,20,30]}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(id == 42);
+    REQUIRE(temp == 21.5);
+    REQUIRE(name == "gps");
+    REQUIRE(second == 20);
+  }
+
+  SECTION("only the kept strings are stored") {
+    int id = 0;
+    JsonString name;
+    extractor.add("id", id);
+    extractor.add("name", name);
+
+    DeserializationError err = extractor.extract(
+        doc, "{\"comment\":\"long string that is skipped\",\"id\":1,"
+             "\"name\":\"abc\"}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(id == 1);
+    REQUIRE(name == "abc");
+    REQUIRE(doc.memoryUsage() == JSON_STRING_SIZE(3));
+  }
+
+  SECTION("JsonVariant output") {
+    JsonVariant sensor;
+    int id = 0;
+    extractor.add("/sensor", sensor);
+    extractor.add("/sensor/id", id);
+
+    DeserializationError err =
+        extractor.extract(doc, "{\"sensor\":{\"id\":7,\"ok\":true},\"x\":1}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(sensor["id"] == 7);
+    REQUIRE(sensor["ok"] == true);
+    REQUIRE(id == 7);
+  }
+
+  SECTION("missing paths") {
+    int a = 1, b = 2;
+    extractor.add("a", a);
+    extractor.add("b.c", b);
+
+    DeserializationError err = extractor.extract(doc, "{\"a\":10,\"b\":[1]}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(a == 10);
+    REQUIRE(b == 2);
+    REQUIRE(extractor.found("a") == true);
+    REQUIRE(extractor.found("b.c") == false);
+    REQUIRE(extractor.found("d") == false);
+  }
+
+  SECTION("JSON Pointer escape sequences") {
+    int a = 0, b = 0;
+    extractor.add("/a~1b", a);
+    extractor.add("/c~0d", b);
+
+    DeserializationError err =
+        extractor.extract(doc, "{\"a/b\":1,\"c~d\":2}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(a == 1);
+    REQUIRE(b == 2);
+  }
+
+  SECTION("root") {
+    int root = 0;
+    extractor.add("", root);
+
+    REQUIRE(extractor.extract(doc, "42") == DeserializationError::Ok);
+    REQUIRE(root == 42);
+  }
+
+  SECTION("stream input") {
+    int id = 0;
+    extractor.add("id", id);
+
+    std::istringstream input("{\"skip\":[{}],\"id\":3}");
+    REQUIRE(extractor.extract(doc, input) == DeserializationError::Ok);
+    REQUIRE(id == 3);
+  }
+
+  SECTION("bounded input") {
+    int id = 0;
+    extractor.add("id", id);
+
+    REQUIRE(extractor.extract(doc, "{\"id\":3}garbage", 8) ==
+            DeserializationError::Ok);
+    REQUIRE(id == 3);
+  }
+
+  SECTION("invalid input") {
+    int id = 0;
+    extractor.add("id", id);
+
+    REQUIRE(extractor.extract(doc, "{\"a\":1 \"id\":2}") ==
+            DeserializationError::InvalidInput);
+    REQUIRE(extractor.extract(doc, "{\"a\":1,\"id\":2") ==
+            DeserializationError::IncompleteInput);
+    REQUIRE(extractor.extract(doc, "") == DeserializationError::EmptyInput);
+  }
+
+  SECTION("nesting limit") {
+    int id = 0;
+    extractor.add("a.id", id);
+
+    REQUIRE(extractor.extract(doc, "{\"a\":{\"id\":1},\"b\":[[1]]}",
+                              DeserializationOption::NestingLimit(2)) ==
+            DeserializationError::TooDeep);
+  }
+
+  SECTION("capacity") {
+    JsonExtractor<3> small;
+    int a = 0, b = 0;
+
+    REQUIRE(small.add("a.b", a) == true);
+    REQUIRE(small.add("c", b) == false);
+  }
+}
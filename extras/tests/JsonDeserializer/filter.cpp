@@ -6,6 +6,7 @@
 #include <ArduinoJson.h>
 #include <catch.hpp>
 
+#include <iterator>
 #include <sstream>
 #include <string>
 
@@ -700,6 +701,354 @@ TEST_CASE("Filtering") {
 
     CHECK(doc.as<std::string>() == tc.output);
     CHECK(doc.memoryUsage() == tc.memoryUsage);
+
+    // a compiled filter must behave exactly like the filter document
+    DeserializationOption::CompiledFilter<16> compiled(filter);
+    REQUIRE(compiled.overflowed() == false);
+    CHECK(deserializeJson(doc, tc.input, compiled,
+                          DeserializationOption::NestingLimit(
+                              tc.nestingLimit)) == tc.error);
+
+    CHECK(doc.as<std::string>() == tc.output);
+    CHECK(doc.memoryUsage() == tc.memoryUsage);
+  }
+}
+
+TEST_CASE("CompiledFilter") {
+  StaticJsonDocument<512> filter;
+  StaticJsonDocument<256> doc;
+
+  SECTION("many keys") {
+    const char* keys[] = {"kiwi", "apple", "mango", "fig",  "banana",
+                          "pear", "lime",  "date",  "plum", "cherry"};
+    for (size_t i = 0; i < 10; i++)
+      filter[keys[i]] = (i % 2) == 0;
+    DeserializationOption::CompiledFilter<11> compiled(filter);
+    REQUIRE(compiled.overflowed() == false);
+
+    DeserializationError err = deserializeJson(
+        doc,
+        "{\"apple\":1,\"banana\":2,\"cherry\":3,\"date\":4,\"fig\":5,"
+        "\"kiwi\":6,\"lime\":7,\"mango\":8,\"pear\":9,\"plum\":10,"
+        "\"grape\":11}",
+        compiled);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() ==
+            "{\"banana\":2,\"kiwi\":6,\"lime\":7,\"mango\":8,\"plum\":10}");
+  }
+
+  SECTION("reused for several documents") {
+    filter["list"][0]["id"] = true;
+    DeserializationOption::CompiledFilter<4> compiled(filter);
+
+    deserializeJson(doc, "{\"list\":[{\"id\":1,\"x\":2}],\"y\":3}",
+                    compiled);
+    REQUIRE(doc.as<std::string>() == "{\"list\":[{\"id\":1}]}");
+
+    deserializeJson(doc, "{\"list\":[{\"x\":2},{\"id\":4}]}", compiled);
+    REQUIRE(doc.as<std::string>() == "{\"list\":[{},{\"id\":4}]}");
+  }
+
+  SECTION("overflow") {
+    filter["a"]["b"] = true;
+    filter["c"] = true;
+    DeserializationOption::CompiledFilter<3> compiled(filter);
+
+    REQUIRE(compiled.overflowed() == true);
+    REQUIRE(deserializeJson(doc, "{\"a\":{\"b\":1},\"c\":2}", compiled) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.isNull());
+  }
+}
+
+TEST_CASE("Skip long strings") {
+  StaticJsonDocument<64> filter;
+  filter["keep"] = true;
+  StaticJsonDocument<256> doc;
+
+  std::string skipped(100, 'x');
+  std::string input = "{\"skip\":\"" + skipped + "'\\\"" + skipped +
+                      "\\\\\",\"keep\":1,'skip2':'" + skipped + "\"'}";
+
+  SECTION("contiguous input") {
+    DeserializationError err =
+        deserializeJson(doc, input, DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"keep\":1}");
+  }
+
+  SECTION("stream input") {
+    std::istringstream stream(input);
+    DeserializationError err =
+        deserializeJson(doc, stream, DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"keep\":1}");
+  }
+
+  SECTION("unterminated string") {
+    DeserializationError err =
+        deserializeJson(doc, "{\"skip\":\"" + skipped,
+                        DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("unterminated string in a bounded input") {
+    DeserializationError err =
+        deserializeJson(doc, input.c_str(), 50,
+                        DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+}
+
+TEST_CASE("StopWhenFilled") {
+  DynamicJsonDocument doc(1024);
+  DynamicJsonDocument filter(256);
+  DeserializationOption::StopWhenFilled stop;
+
+  SECTION("leaves the rest of the stream unread") {
+    filter["id"] = true;
+    filter["header"]["status"] = true;
+    std::istringstream input(
+        "{\"id\":1,\"header\":{\"status\":\"ok\",\"time\":3},\"data\":[1,2]}");
+
+    DeserializationError err = deserializeJson(
+        doc, input, DeserializationOption::Filter(filter), stop);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() ==
+            "{\"id\":1,\"header\":{\"status\":\"ok\"}}");
+    std::string rest((std::istreambuf_iterator<char>(input)),
+                     std::istreambuf_iterator<char>());
+    REQUIRE(rest == ",\"time\":3},\"data\":[1,2]}");
+  }
+
+  SECTION("doesn't validate the rest of the input") {
+    filter["a"] = true;
+
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":\"x\",garbage",
+                        DeserializationOption::Filter(filter), stop);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":\"x\"}");
+  }
+
+  SECTION("waits for the end of a value allowed by true") {
+    filter["a"] = true;
+    filter["b"] = true;
+    std::istringstream input("{\"b\":1,\"a\":{\"x\":[1,2]},\"c\":3}");
+
+    deserializeJson(doc, input, DeserializationOption::Filter(filter), stop);
+
+    REQUIRE(doc.as<std::string>() == "{\"b\":1,\"a\":{\"x\":[1,2]}}");
+    REQUIRE(input.get() == ',');
+  }
+
+  SECTION("duplicate keys count once") {
+    filter["a"] = true;
+    filter["b"] = true;
+
+    deserializeJson(doc, "{\"a\":1,\"a\":2,\"b\":3}",
+                    DeserializationOption::Filter(filter), stop);
+
+    REQUIRE(doc.as<std::string>() == "{\"a\":2,\"b\":3}");
+  }
+
+  SECTION("missing path reads to the end") {
+    filter["a"] = true;
+    filter["z"] = true;
+
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":1,\"b\":2}garbage",
+                        DeserializationOption::Filter(filter), stop);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1}");
+  }
+
+  SECTION("wildcard disables the option") {
+    filter["a"] = true;
+    filter["*"]["x"] = true;
+    std::istringstream input("{\"a\":1,\"b\":{\"x\":2}}");
+
+    deserializeJson(doc, input, DeserializationOption::Filter(filter), stop);
+
+    REQUIRE(doc.as<std::string>() == "{\"a\":1,\"b\":{\"x\":2}}");
+  }
+
+  SECTION("array disables the option") {
+    filter["a"] = true;
+    filter["list"][0]["x"] = true;
+
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":1,\"list\":[{\"x\":1}]",
+                        DeserializationOption::Filter(filter), stop);
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("CompiledFilter") {
+    filter["a"]["b"] = true;
+    DeserializationOption::CompiledFilter<8> compiled(filter);
+
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":{\"b\":true,", compiled, stop);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":{\"b\":true}}");
+  }
+
+  SECTION("without filter") {
+    DeserializationError err = deserializeJson(doc, "{\"a\":1,", stop);
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("disabled") {
+    filter["a"] = true;
+
+    DeserializationError err = deserializeJson(
+        doc, "{\"a\":1,", DeserializationOption::Filter(filter),
+        DeserializationOption::StopWhenFilled(false));
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+}
+
+TEST_CASE("ElementFilter") {
+  DynamicJsonDocument doc(1024);
+  DynamicJsonDocument filter(256);
+  filter["events"][0]["type"] = true;
+  filter["events"][0]["value"] = true;
+  filter["count"] = true;
+  DeserializationOption::ElementFilter elements(filter, filter["events"]);
+  const char* input =
+      "{\"count\":4,\"events\":["
+      "{\"type\":\"a\",\"value\":0,\"x\":0},"
+      "{\"type\":\"b\",\"value\":1,\"x\":1},"
+      "{\"type\":\"a\",\"value\":2,\"x\":2},"
+      "{\"type\":\"b\",\"value\":3,\"x\":3}]}";
+
+  SECTION("behaves like Filter by default") {
+    DeserializationError err = deserializeJson(doc, input, elements);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["events"].size() == 4);
+    REQUIRE(doc["events"][3]["value"] == 3);
+    REQUIRE(doc["events"][3]["x"].isNull());
+  }
+
+  SECTION("first elements") {
+    elements.slice(0, 2);
+
+    deserializeJson(doc, input, elements);
+
+    REQUIRE(doc.as<std::string>() ==
+            "{\"count\":4,\"events\":[{\"type\":\"a\",\"value\":0},"
+            "{\"type\":\"b\",\"value\":1}]}");
+  }
+
+  SECTION("every other element") {
+    elements.slice(1, size_t(-1), 2);
+
+    deserializeJson(doc, input, elements);
+
+    REQUIRE(doc["events"].size() == 2);
+    REQUIRE(doc["events"][0]["value"] == 1);
+    REQUIRE(doc["events"][1]["value"] == 3);
+  }
+
+  SECTION("range") {
+    elements.slice(1, 3);
+
+    deserializeJson(doc, input, elements);
+
+    REQUIRE(doc["events"].size() == 2);
+    REQUIRE(doc["events"][0]["value"] == 1);
+    REQUIRE(doc["events"][1]["value"] == 2);
+  }
+
+  SECTION("predicate") {
+    elements.where([](JsonVariantConst e) { return e["type"] == "b"; });
+
+    DeserializationError err = deserializeJson(doc, input, elements);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() ==
+            "{\"count\":4,\"events\":[{\"type\":\"b\",\"value\":1},"
+            "{\"type\":\"b\",\"value\":3}]}");
+  }
+
+  SECTION("predicate and slice") {
+    elements.slice(2).where(
+        [](JsonVariantConst e) { return e["type"] == "b"; });
+
+    deserializeJson(doc, input, elements);
+
+    REQUIRE(doc["events"].size() == 1);
+    REQUIRE(doc["events"][0]["value"] == 3);
+  }
+
+  SECTION("rejected elements release their memory") {
+    elements.where([](JsonVariantConst e) { return e["value"] == 3; });
+    DynamicJsonDocument expected(1024);
+    deserializeJson(expected,
+                    "{\"count\":4,\"events\":[{\"type\":\"b\","
+                    "\"value\":3}]}");
+
+    deserializeJson(doc, input, elements);
+
+    REQUIRE(doc == expected);
+    REQUIRE(doc.memoryUsage() == expected.memoryUsage());
+  }
+
+  SECTION("rejecting everything leaves an empty array") {
+    elements.where([](JsonVariantConst) { return false; });
+
+    deserializeJson(doc, input, elements);
+
+    REQUIRE(doc.as<std::string>() == "{\"count\":4,\"events\":[]}");
+  }
+
+  SECTION("predicate on scalar elements") {
+    filter.clear();
+    filter[0] = true;
+    DeserializationOption::ElementFilter root(filter);
+    root.where([](JsonVariantConst e) {
+      return e.is<int>() && e.as<int>() % 2 == 0;
+    });
+
+    deserializeJson(doc, "[1,2,\"x\",4,[6],{\"a\":8},10]", root);
+
+    REQUIRE(doc.as<std::string>() == "[2,4,10]");
+  }
+
+  SECTION("other arrays are not sliced") {
+    filter.clear();
+    filter["a"][0] = true;
+    filter["b"][0] = true;
+    DeserializationOption::ElementFilter sliced(filter, filter["b"]);
+    sliced.slice(0, 1);
+
+    deserializeJson(doc, "{\"a\":[1,2],\"b\":[3,4]}", sliced);
+
+    REQUIRE(doc.as<std::string>() == "{\"a\":[1,2],\"b\":[3]}");
+  }
+
+  SECTION("applies to each array matched by a wildcard") {
+    filter.clear();
+    filter["*"][0] = true;
+    DeserializationOption::ElementFilter sliced(filter, filter["*"]);
+    sliced.slice(1, 2);
+
+    deserializeJson(doc, "{\"a\":[1,2,3],\"b\":[4,5]}", sliced);
+
+    REQUIRE(doc.as<std::string>() == "{\"a\":[2],\"b\":[5]}");
   }
 }
 
@@ -779,6 +1128,24 @@ TEST_CASE("Overloads") {
   }
 #endif
 
+  // deserializeJson(..., CompiledFilter)
+
+  SECTION("const char*, CompiledFilter") {
+    CompiledFilter<1> compiled(filter);
+    deserializeJson(doc, "{}", compiled);
+  }
+
+  SECTION("const char*, size_t, CompiledFilter, NestingLimit") {
+    CompiledFilter<1> compiled(filter);
+    deserializeJson(doc, "{}", 2, compiled, NestingLimit(5));
+  }
+
+  SECTION("std::istream&, NestingLimit, CompiledFilter") {
+    CompiledFilter<1> compiled(filter);
+    std::stringstream s("{}");
+    deserializeJson(doc, s, NestingLimit(5), compiled);
+  }
+
   // deserializeJson(..., NestingLimit, Filter)
 
   SECTION("const char*, NestingLimit, Filter") {
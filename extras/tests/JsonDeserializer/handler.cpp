@@ -0,0 +1,171 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+// Records the events in a string
+struct SpyingHandler {
+  std::ostringstream log;
+  std::string skippedKey;
+  bool skipArrays = false;
+
+  bool onObjectStart() {
+    log << "{";
+    return true;
+  }
+
+  void onObjectEnd() {
+    log << "}";
+  }
+
+  bool onKey(JsonString key) {
+    log << key.c_str() << ":";
+    return skippedKey != key.c_str();
+  }
+
+  bool onArrayStart() {
+    log << "[";
+    return !skipArrays;
+  }
+
+  void onArrayEnd() {
+    log << "]";
+  }
+
+  void onString(JsonString value) {
+    log << "s(" << value.c_str() << ")";
+  }
+
+  void onInteger(JsonInteger value) {
+    log << "i(" << value << ")";
+  }
+
+  void onInteger(JsonUInt value) {
+    log << "u(" << value << ")";
+  }
+
+  void onFloat(JsonFloat value) {
+    log << "f(" << value << ")";
+  }
+
+  void onBool(bool value) {
+    log << "b(" << value << ")";
+  }
+
+  void onNull() {
+    log << "n";
+  }
+};
+
+TEST_CASE("deserializeJson(handler)") {
+  SpyingHandler handler;
+
+  SECTION("scalars") {
+    REQUIRE(deserializeJson(handler, "[\"hello\",-42,42,1.5,true,null]") ==
+            DeserializationError::Ok);
+    REQUIRE(handler.log.str() == "[s(hello)i(-42)u(42)f(1.5)b(1)n]");
+  }
+
+  SECTION("nested") {
+    REQUIRE(deserializeJson(handler, "{\"a\":{\"b\":[]},\"c\":{}}") ==
+            DeserializationError::Ok);
+    REQUIRE(handler.log.str() == "{a:{b:[]}c:{}}");
+  }
+
+  SECTION("value at the root") {
+    REQUIRE(deserializeJson(handler, "\"hello\"") == DeserializationError::Ok);
+    REQUIRE(handler.log.str() == "s(hello)");
+  }
+
+  SECTION("onKey() returns false") {
+    handler.skippedKey = "b";
+    REQUIRE(deserializeJson(handler, "{\"a\":1,\"b\":{\"x\":[2]},\"c\":3}") ==
+            DeserializationError::Ok);
+    REQUIRE(handler.log.str() == "{a:u(1)b:c:u(3)}");
+  }
+
+  SECTION("onArrayStart() returns false") {
+    handler.skipArrays = true;
+    REQUIRE(deserializeJson(handler, "{\"a\":[1,[2]],\"b\":3}") ==
+            DeserializationError::Ok);
+    REQUIRE(handler.log.str() == "{a:[b:u(3)}");
+  }
+
+  SECTION("mutable input") {
+    char input[] = "{\"a\":\"b\"}";
+    REQUIRE(deserializeJson(handler, input) == DeserializationError::Ok);
+    REQUIRE(handler.log.str() == "{a:s(b)}");
+  }
+
+  SECTION("input with size") {
+    REQUIRE(deserializeJson(handler, "[1,2]", 4) ==
+            DeserializationError::IncompleteInput);
+  }
+
+  SECTION("std::istream") {
+    std::istringstream input("[\"hello\"]");
+    REQUIRE(deserializeJson(handler, input) == DeserializationError::Ok);
+    REQUIRE(handler.log.str() == "[s(hello)]");
+  }
+
+  SECTION("invalid input") {
+    REQUIRE(deserializeJson(handler, "[1,]") ==
+            DeserializationError::InvalidInput);
+  }
+
+  SECTION("trailing characters") {
+    REQUIRE(deserializeJson(handler, "truex") ==
+            DeserializationError::InvalidInput);
+  }
+
+  SECTION("empty input") {
+    REQUIRE(deserializeJson(handler, "") == DeserializationError::EmptyInput);
+  }
+
+  SECTION("nesting limit") {
+    REQUIRE(deserializeJson(handler, "[[]]",
+                            DeserializationOption::NestingLimit(1)) ==
+            DeserializationError::TooDeep);
+  }
+
+  SECTION("string longer than the buffer") {
+    std::string input =
+        "\"" + std::string(ARDUINOJSON_HANDLER_BUFFER_SIZE, 'x') + "\"";
+    REQUIRE(deserializeJson(handler, input) ==
+            DeserializationError::StringTooLong);
+
+    std::istringstream stream(input);
+    REQUIRE(deserializeJson(handler, stream) ==
+            DeserializationError::StringTooLong);
+  }
+
+  SECTION("long string in a writable input") {
+    std::string input =
+        "\"" + std::string(ARDUINOJSON_HANDLER_BUFFER_SIZE, 'x') + "\"";
+    REQUIRE(deserializeJson(handler, &input[0]) == DeserializationError::Ok);
+  }
+}
+
+TEST_CASE("IsHandler") {
+  using namespace ArduinoJson::detail;
+
+  SECTION("a class with the member functions of a handler") {
+    CHECK(IsHandler<SpyingHandler>::value == true);
+  }
+
+  SECTION("the documents and the variants") {
+    CHECK(IsHandler<StaticJsonDocument<64> >::value == false);
+    CHECK(IsHandler<DynamicJsonDocument>::value == false);
+    CHECK(IsHandler<JsonVariant>::value == false);
+  }
+
+  SECTION("other types") {
+    CHECK(IsHandler<int>::value == false);
+    CHECK(IsHandler<std::string>::value == false);
+  }
+}
@@ -6,6 +6,8 @@
 
 #include <catch.hpp>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "CustomReader.hpp"
 
@@ -77,6 +79,63 @@ TEST_CASE("deserializeJson(const std::string&)") {
   }
 }
 
+TEST_CASE("deserializeJson(inSitu(...))") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("std::string") {
+    std::string input("{\"hello\":\"world\"}");
+
+    DeserializationError err = deserializeJson(doc, inSitu(input));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1));
+    REQUIRE(doc["hello"] == "world");
+    REQUIRE(doc["hello"].as<const char*>() >= input.data());
+    REQUIRE(doc["hello"].as<const char*>() < input.data() + input.size());
+  }
+
+  SECTION("std::vector<char>") {
+    std::string json("[\"hello\",\"world\"]");
+    std::vector<char> input(json.begin(), json.end());
+
+    DeserializationError err = deserializeJson(doc, inSitu(input));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2));
+    REQUIRE(doc[0] == "hello");
+    REQUIRE(doc[1] == "world");
+  }
+
+  SECTION("empty std::vector<char>") {
+    std::vector<char> input;
+
+    DeserializationError err = deserializeJson(doc, inSitu(input));
+
+    REQUIRE(err == DeserializationError::EmptyInput);
+  }
+
+  SECTION("escaped strings") {
+    std::string input("[\"1\\t2\",\"\\u00e9\"]");
+
+    DeserializationError err = deserializeJson(doc, inSitu(input));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "1\t2");
+    REQUIRE(doc[1] == "\xC3\xA9");
+  }
+}
+
+TEST_CASE("InSituJsonDocument") {
+  InSituJsonDocument<std::string> doc(4096);
+  doc.input() = "{\"hello\":\"world\"}";
+
+  DeserializationError err = deserializeJson(doc, doc.inSitu());
+
+  REQUIRE(err == DeserializationError::Ok);
+  REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1));
+  REQUIRE(doc["hello"] == "world");
+}
+
 TEST_CASE("deserializeJson(std::istream&)") {
   DynamicJsonDocument doc(4096);
 
@@ -220,3 +279,45 @@ TEST_CASE("deserializeJson(JsonDocument&, ElementProxy)") {
   REQUIRE(doc2[0] == 4);
   REQUIRE(doc2[1] == 2);
 }
+
+TEST_CASE("deserializeJson() returns the same error for all input types") {
+  const char* inputs[] = {
+      "",
+      " ",
+      "[1,2,3]",
+      "[1,2,",
+      "[1,2]x",
+      "{\"a\":1,\"b\":[true,false,null]}",
+      "{\"a\":1,",
+      "{a:1}",
+      "{\"a\"1}",
+      "\"hello\\nworld\"",
+      "\"hello",
+      "\"\\",
+      "\"\\u00e9\"",
+      "\"\\u00",
+      "\"\\x\"",
+      "tru",
+      "trux",
+      "-",
+      "1.5e3",
+      "42x",
+      "[[[[[[[[[[[[[[[[[[[[1]]]]]]]]]]]]]]]]]]]",
+  };
+
+  for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+    CAPTURE(inputs[i]);
+    DynamicJsonDocument doc1(4096), doc2(4096), doc3(4096);
+
+    std::istringstream stream(inputs[i]);
+    DeserializationError err1 = deserializeJson(doc1, stream);
+    DeserializationError err2 = deserializeJson(doc2, inputs[i]);
+    DeserializationError err3 =
+        deserializeJson(doc3, inputs[i], strlen(inputs[i]));
+
+    CHECK(err1 == err2);
+    CHECK(err1 == err3);
+    CHECK(doc1 == doc2);
+    CHECK(doc1 == doc3);
+  }
+}
@@ -0,0 +1,209 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+TEST_CASE("LazyJsonDocument") {
+  StaticJsonDocument<256> storage;
+
+  SECTION("reads a member without parsing the others") {
+    const char* input = "{\"a\":[1,2,{\"x\":\"y\"}],\"b\":\"hello\",\"c\":42}";
+    LazyJsonDocument doc(storage, input);
+
+    REQUIRE(doc["c"].as<int>() == 42);
+    REQUIRE(doc["b"].as<std::string>() == "hello");
+    REQUIRE(doc["b"].as<const char*>() == std::string("hello"));
+    REQUIRE(storage.memoryUsage() ==
+            JSON_ARRAY_SIZE(1) + JSON_STRING_SIZE(5));
+  }
+
+  SECTION("as<T>() doesn't keep a copy of the value") {
+    LazyJsonDocument doc(storage, "{\"a\":42,\"b\":\"hello\",\"c\":[1,2]}");
+
+    for (int i = 0; i < 3; i++) {
+      REQUIRE(doc["a"].as<int>() == 42);
+      REQUIRE(doc["b"].as<std::string>() == "hello");
+      REQUIRE(doc["c"].as<std::string>() == "[1,2]");
+      REQUIRE(storage.memoryUsage() == 0);
+    }
+  }
+
+  SECTION("nested members and elements") {
+    LazyJsonDocument doc(storage, "{\"a\":[1,2,{\"x\":\"y\"}]}");
+
+    REQUIRE(doc["a"][1].as<int>() == 2);
+    REQUIRE(doc["a"][2]["x"].as<std::string>() == "y");
+  }
+
+  SECTION("materialize() parses the whole value") {
+    LazyJsonDocument doc(storage, "{\"a\":{\"b\":[1,2]},\"c\":3}");
+
+    JsonVariantConst a = doc["a"].materialize();
+    REQUIRE(a["b"][0] == 1);
+    REQUIRE(a["b"][1] == 2);
+  }
+
+  SECTION("materialize() keeps one copy of the value") {
+    LazyJsonDocument doc(storage, "{\"a\":{\"b\":[1,2]},\"c\":\"hello\"}");
+
+    doc["a"].materialize();
+    size_t memoryUsage = storage.memoryUsage();
+
+    for (int i = 0; i < 3; i++) {
+      REQUIRE(doc["a"].materialize()["b"][1] == 2);
+      REQUIRE(doc["a"]["b"].as<std::string>() == "[1,2]");
+      REQUIRE(doc["a"].as<std::string>() == "{\"b\":[1,2]}");
+      REQUIRE(storage.memoryUsage() == memoryUsage);
+    }
+
+    REQUIRE(doc["c"].as<const char*>() == std::string("hello"));
+    memoryUsage = storage.memoryUsage();
+    REQUIRE(doc["c"].as<const char*>() == std::string("hello"));
+    REQUIRE(doc["c"].as<std::string>() == "hello");
+    REQUIRE(storage.memoryUsage() == memoryUsage);
+    REQUIRE(storage.size() == 2);
+  }
+
+  SECTION("more materialized values than ARDUINOJSON_LAZY_INDEX_SIZE") {
+    std::string input = "[";
+    for (int i = 0; i < ARDUINOJSON_LAZY_INDEX_SIZE + 2; i++)
+      input += (i ? "," : "") + std::to_string(i);
+    input += "]";
+    DynamicJsonDocument bigStorage(4096);
+    LazyJsonDocument doc(bigStorage, input.c_str());
+
+    for (int j = 0; j < 2; j++) {
+      for (int i = 0; i < ARDUINOJSON_LAZY_INDEX_SIZE + 2; i++)
+        REQUIRE(doc[size_t(i)].materialize() == i);
+    }
+    REQUIRE(bigStorage.size() == ARDUINOJSON_LAZY_INDEX_SIZE + 4);
+  }
+
+  SECTION("looks up a member only once") {
+    char input[] = "{\"a\":[1,2],\"b\":3}";
+    LazyJsonDocument doc(storage, input);
+
+    REQUIRE(doc["b"].as<int>() == 3);
+
+    input[5] = '?';  // the first member is now invalid
+    REQUIRE(doc["b"].as<int>() == 3);
+    REQUIRE(doc["a"].error() == DeserializationError::InvalidInput);
+  }
+
+  SECTION("missing member") {
+    LazyJsonDocument doc(storage, "{\"a\":1}");
+
+    LazyJsonValue value = doc["b"];
+    REQUIRE(value.isUnbound());
+    REQUIRE(value.error() == DeserializationError::Ok);
+    REQUIRE(value.materialize().isNull());
+    REQUIRE(storage.memoryUsage() == 0);
+  }
+
+  SECTION("index out of range") {
+    LazyJsonDocument doc(storage, "[1,2]");
+
+    REQUIRE(doc[1].as<int>() == 2);
+    REQUIRE(doc[2].isUnbound());
+  }
+
+  SECTION("member of a value that is not an object") {
+    LazyJsonDocument doc(storage, "[1,2]");
+
+    REQUIRE(doc["a"].isUnbound());
+    REQUIRE(doc[0]["a"].isUnbound());
+  }
+
+  SECTION("key with escape sequence") {
+    LazyJsonDocument doc(storage, "{\"a\\\"b\":1,'c':2,d:3}");
+
+    REQUIRE(doc["a\"b"].as<int>() == 1);
+    REQUIRE(doc["c"].as<int>() == 2);
+    REQUIRE(doc["d"].as<int>() == 3);
+  }
+
+  SECTION("spaces") {
+    LazyJsonDocument doc(storage, " { \"a\" : 1 ,\n \"b\" : [ 2 ] } ");
+
+    REQUIRE(doc["b"][0].as<int>() == 2);
+  }
+
+  SECTION("iterates over the members") {
+    LazyJsonDocument doc(storage, "{\"a\":1,\"b\":[2],\"c\":\"3\"}");
+
+    std::string keys;
+    for (LazyJsonIterator it = doc.begin(); it != doc.end(); ++it)
+      keys += it.key().c_str();
+    REQUIRE(keys == "abc");
+  }
+
+  SECTION("iterates over the elements") {
+    LazyJsonDocument doc(storage, "[1,2,3]");
+
+    int sum = 0;
+    for (LazyJsonValue value : doc)
+      sum += value.as<int>();
+    REQUIRE(sum == 6);
+  }
+
+  SECTION("bounded input") {
+    LazyJsonDocument doc(storage, "[1,2][3]", 5);
+
+    REQUIRE(doc[1].as<int>() == 2);
+    REQUIRE(doc[2].isUnbound());
+  }
+
+  SECTION("invalid input") {
+    LazyJsonDocument doc(storage, "{\"a\":1 \"b\":2}");
+
+    REQUIRE(doc["a"].as<int>() == 1);
+    REQUIRE(doc["b"].error() == DeserializationError::InvalidInput);
+  }
+
+  SECTION("trailing comma") {
+    LazyJsonDocument doc(storage, "[1,]");
+
+    REQUIRE(doc[1].error() == DeserializationError::InvalidInput);
+  }
+
+  SECTION("incomplete input") {
+    LazyJsonDocument doc(storage, "{\"a\":[1,2");
+
+    REQUIRE(doc["b"].error() == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("nesting limit") {
+    SECTION("within the limit") {
+      LazyJsonDocument doc(storage, "{\"a\":{\"b\":1}}",
+                           DeserializationOption::NestingLimit(2));
+
+      REQUIRE(doc["a"]["b"].as<int>() == 1);
+    }
+
+    SECTION("above the limit") {
+      LazyJsonDocument doc(storage, "{\"a\":{\"b\":[1]}}",
+                           DeserializationOption::NestingLimit(2));
+
+      REQUIRE(doc["a"]["b"].error() == DeserializationError::TooDeep);
+    }
+  }
+
+  SECTION("key longer than the buffer") {
+    std::string input =
+        "{\"" + std::string(ARDUINOJSON_HANDLER_BUFFER_SIZE, 'x') + "\":1}";
+    LazyJsonDocument doc(storage, input.c_str());
+
+    REQUIRE(doc["a"].error() == DeserializationError::StringTooLong);
+  }
+
+  SECTION("storage overflow") {
+    StaticJsonDocument<8> tiny;
+    LazyJsonDocument doc(tiny, "{\"a\":\"hello world\"}");
+
+    REQUIRE(doc["a"].materialize().isNull());
+  }
+}
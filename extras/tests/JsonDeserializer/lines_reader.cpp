@@ -0,0 +1,186 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("JsonLinesReader") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("JSON Lines in a buffer") {
+    auto reader = makeJsonLinesReader("{\"a\":1}\n[2]\n3\n\"four\"\n");
+
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc["a"] == 1);
+    REQUIRE(reader.offset() == 7);
+
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc[0] == 2);
+    REQUIRE(reader.offset() == 11);
+
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc == 3);
+    REQUIRE(reader.offset() == 13);
+
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc == "four");
+    REQUIRE(reader.offset() == 20);
+
+    REQUIRE(reader.read(doc) == DeserializationError::EmptyInput);
+    REQUIRE(reader.offset() == 21);
+  }
+
+  SECTION("concatenated values in a stream") {
+    std::istringstream input("1 2{\"a\":3}[4]true");
+    auto reader = makeJsonLinesReader(input);
+
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc == 1);
+    REQUIRE(reader.offset() == 1);
+
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc == 2);
+    REQUIRE(reader.offset() == 3);
+
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc["a"] == 3);
+
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc[0] == 4);
+
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc == true);
+    REQUIRE(reader.offset() == 17);
+
+    REQUIRE(reader.read(doc) == DeserializationError::EmptyInput);
+  }
+
+  SECTION("sized input") {
+    auto reader = makeJsonLinesReader("[1]\n[2]\n[3]", 8);
+
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc[0] == 2);
+    REQUIRE(reader.read(doc) == DeserializationError::EmptyInput);
+  }
+
+  SECTION("incomplete value") {
+    auto reader = makeJsonLinesReader("[1]\n[2");
+
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(reader.read(doc) == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("resumes after an invalid line") {
+    std::istringstream input("[1]\n{\"a\":x,\"b\":2}\n[3]\n[4 5]\n[6]");
+    auto reader = makeJsonLinesReader(input);
+
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc[0] == 1);
+
+    REQUIRE(reader.read(doc) == DeserializationError::InvalidInput);
+
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc[0] == 3);
+
+    REQUIRE(reader.read(doc) == DeserializationError::InvalidInput);
+
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc[0] == 6);
+
+    REQUIRE(reader.read(doc) == DeserializationError::EmptyInput);
+  }
+
+  SECTION("filter") {
+    StaticJsonDocument<64> filter;
+    filter["a"] = true;
+    auto reader = makeJsonLinesReader("{\"a\":1,\"b\":2}\n{\"b\":3,\"a\":4}");
+
+    REQUIRE(reader.read(doc, DeserializationOption::Filter(filter)) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1}");
+
+    REQUIRE(reader.read(doc, DeserializationOption::Filter(filter)) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":4}");
+  }
+
+  SECTION("StopWhenFilled") {
+    StaticJsonDocument<64> filter;
+    filter["a"] = true;
+    std::istringstream input("{\"a\":1,\"b\":2}\n{\"a\":3,garbage\n[4]\n");
+    auto reader = makeJsonLinesReader(input);
+
+    REQUIRE(reader.read(doc, DeserializationOption::Filter(filter),
+                        DeserializationOption::StopWhenFilled()) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1}");
+    REQUIRE(reader.offset() == 14);
+
+    REQUIRE(reader.read(doc, DeserializationOption::Filter(filter),
+                        DeserializationOption::StopWhenFilled()) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":3}");
+
+    REQUIRE(reader.read(doc) == DeserializationError::Ok);
+    REQUIRE(doc[0] == 4);
+    REQUIRE(reader.read(doc) == DeserializationError::EmptyInput);
+  }
+
+  SECTION("each value goes to the specified document") {
+    StaticJsonDocument<128> doc1, doc2;
+    auto reader = makeJsonLinesReader("[\"hello\"]\n[\"world\"]");
+
+    REQUIRE(reader.read(doc1) == DeserializationError::Ok);
+    REQUIRE(reader.read(doc2) == DeserializationError::Ok);
+    REQUIRE(doc1[0] == "hello");
+    REQUIRE(doc2[0] == "world");
+  }
+}
+
+TEST_CASE("splitJsonLines()") {
+  std::vector<std::string> chunks;
+  auto collect = [&](size_t index, const char* chunk, size_t size) {
+    REQUIRE(index == chunks.size());
+    chunks.push_back(std::string(chunk, size));
+  };
+
+  SECTION("splits at newlines") {
+    const char* input = "[1]\n[22]\n[333]\n[4444]\n";
+    REQUIRE(splitJsonLines(input, strlen(input), 3, collect) == 3);
+    REQUIRE(chunks[0] == "[1]\n[22]\n");
+    REQUIRE(chunks[1] == "[333]\n");
+    REQUIRE(chunks[2] == "[4444]\n");
+  }
+
+  SECTION("last line without newline") {
+    const char* input = "[1]\n[2]";
+    REQUIRE(splitJsonLines(input, strlen(input), 2, collect) == 2);
+    REQUIRE(chunks[0] == "[1]\n");
+    REQUIRE(chunks[1] == "[2]");
+  }
+
+  SECTION("fewer lines than chunks") {
+    const char* input = "[1]\n";
+    REQUIRE(splitJsonLines(input, strlen(input), 4, collect) == 1);
+    REQUIRE(chunks[0] == "[1]\n");
+  }
+
+  SECTION("each chunk can be parsed") {
+    const char* input = "1\n2\n3\n4\n5\n6\n7\n";
+    int sum = 0;
+    splitJsonLines(input, strlen(input), 3,
+                   [&](size_t, const char* chunk, size_t size) {
+                     StaticJsonDocument<16> doc;
+                     auto reader = makeJsonLinesReader(chunk, size);
+                     while (reader.read(doc) == DeserializationError::Ok)
+                       sum += doc.as<int>();
+                   });
+    REQUIRE(sum == 28);
+  }
+}
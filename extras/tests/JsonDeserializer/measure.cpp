@@ -0,0 +1,158 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+// An allocator that fails above 64 bytes
+struct TinyAllocator {
+  void* allocate(size_t size) {
+    return size <= 64 ? malloc(size) : 0;
+  }
+
+  void deallocate(void* ptr) {
+    free(ptr);
+  }
+
+  void* reallocate(void* ptr, size_t size) {
+    return size <= 64 ? realloc(ptr, size) : 0;
+  }
+};
+
+static size_t usage(const char* json) {
+  DynamicJsonDocument doc(4096);
+  REQUIRE(deserializeJson(doc, json) == DeserializationError::Ok);
+  return doc.memoryUsage();
+}
+
+TEST_CASE("measureDeserializeJson()") {
+  SECTION("matches memoryUsage()") {
+    const char* inputs[] = {
+        "42",
+        "\"hello\"",
+        "[]",
+        "[1,2,3]",
+        "{\"a\":1,\"b\":[true,null,\"x\"],\"c\":{\"d\":\"e\"}}",
+        "[{\"id\":1,\"name\":\"a\"},{\"id\":2,\"name\":\"a\"}]",
+        "{\"escaped\":\"\\u00e9\\n\",unquoted:'single'}",
+    };
+    for (const char* input : inputs) {
+      CAPTURE(input);
+      REQUIRE(measureDeserializeJson(input) == usage(input));
+    }
+  }
+
+  SECTION("the result is enough to deserialize") {
+    std::string input = "{\"list\":[";
+    for (int i = 0; i < 100; i++) {
+      if (i)
+        input += ",";
+      input += "{\"key" + std::to_string(i % 7) + "\":\"value" +
+               std::to_string(i) + "\"}";
+    }
+    input += "]}";
+
+    size_t capacity = measureDeserializeJson(input);
+    DynamicJsonDocument doc(capacity);
+    DeserializationError err = deserializeJson(doc, input);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.memoryUsage() == capacity);
+    REQUIRE(doc["list"].size() == 100);
+  }
+
+  SECTION("counts the duplicated strings once") {
+    REQUIRE(measureDeserializeJson("[\"abc\",\"abc\",\"abc\"]") ==
+            JSON_ARRAY_SIZE(3) + JSON_STRING_SIZE(3));
+  }
+
+  SECTION("applies the filter") {
+    DynamicJsonDocument filter(128);
+    filter["a"] = true;
+    const char* input = "{\"a\":\"hello\",\"b\":\"world\"}";
+
+    size_t capacity =
+        measureDeserializeJson(input, DeserializationOption::Filter(filter));
+
+    REQUIRE(capacity ==
+            JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(1) + JSON_STRING_SIZE(5));
+  }
+
+  SECTION("applies the options") {
+    const char* input = "[\"hello\",3.14]";
+
+    REQUIRE(measureDeserializeJson(input) ==
+            JSON_ARRAY_SIZE(2) + JSON_STRING_SIZE(5));
+    REQUIRE(measureDeserializeJson(input, DeserializationOption::ZeroCopy()) ==
+            JSON_ARRAY_SIZE(2));
+    REQUIRE(measureDeserializeJson(input,
+                                   DeserializationOption::LazyNumbers()) ==
+            JSON_ARRAY_SIZE(2) + JSON_STRING_SIZE(5) + JSON_STRING_SIZE(4));
+  }
+
+  SECTION("doesn't modify a char*") {
+    char input[] = "[\"hello\",\"world\"]";
+
+    size_t capacity = measureDeserializeJson(input);
+
+    REQUIRE(capacity == JSON_ARRAY_SIZE(2));  // the strings stay in place
+    REQUIRE(std::string(input) == "[\"hello\",\"world\"]");
+  }
+
+  SECTION("counts each element of ElementFilter") {
+    DynamicJsonDocument filter(128);
+    filter[0] = true;
+    DeserializationOption::ElementFilter elements(filter);
+    elements.slice(0, 2).where([](JsonVariantConst) { return false; });
+
+    REQUIRE(measureDeserializeJson("[1,2,3]", elements) == JSON_ARRAY_SIZE(2));
+  }
+
+  SECTION("returns 0 for invalid input") {
+    REQUIRE(measureDeserializeJson("[1,2") == 0);
+    REQUIRE(measureDeserializeJson("{\"a\":}") == 0);
+  }
+
+  SECTION("const char*, size_t") {
+    REQUIRE(measureDeserializeJson("[1,2]garbage", 5) == JSON_ARRAY_SIZE(2));
+  }
+}
+
+TEST_CASE("CountedStrings") {
+  using namespace ArduinoJson::detail;
+  CountedStrings<TinyAllocator> strings;
+
+  auto save = [&](const std::string& s) {
+    strings.startString();
+    strings.append(s.c_str(), s.size());
+    return std::string(strings.save(true).c_str());
+  };
+
+  SECTION("counts each string once") {
+    REQUIRE(save("hello") == "hello");
+    REQUIRE(save("world") == "world");
+    REQUIRE(save("hello") == "hello");
+    REQUIRE(strings.bytes() == 12);
+    REQUIRE(strings.overflowed() == false);
+  }
+
+  SECTION("forgets the strings when the allocator fails") {
+    for (char c = 'a'; c <= 'z'; c++)
+      REQUIRE(save(std::string(4, c)) == std::string(4, c));
+    REQUIRE(strings.bytes() == 26 * 5);
+    REQUIRE(strings.overflowed() == false);
+
+    // the duplicates count twice, so the result is still large enough
+    REQUIRE(save("aaaa") == "aaaa");
+    REQUIRE(strings.bytes() == 27 * 5);
+    REQUIRE(strings.overflowed() == false);
+  }
+
+  SECTION("overflows when the current string doesn't fit") {
+    save(std::string(100, 'x'));
+    REQUIRE(strings.overflowed() == true);
+  }
+}
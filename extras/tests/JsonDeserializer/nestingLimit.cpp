@@ -6,6 +6,7 @@
 #include <catch.hpp>
 
 #include <sstream>
+#include <string>
 
 #define SHOULD_WORK(expression) REQUIRE(DeserializationError::Ok == expression);
 #define SHOULD_FAIL(expression) \
@@ -100,4 +101,36 @@ TEST_CASE("JsonDeserializer nesting") {
       SHOULD_FAIL(deserializeJson(doc, bad, nesting));
     }
   }
+
+  SECTION("Deep nesting") {
+    DeserializationOption::NestingLimit nesting(5000);
+    DynamicJsonDocument bigDoc(JSON_ARRAY_SIZE(1) * 5000 + 100);
+
+    SECTION("array") {
+      std::string input = std::string(5000, '[') + std::string(5000, ']');
+      SHOULD_WORK(deserializeJson(bigDoc, input, nesting));
+      SHOULD_FAIL(deserializeJson(bigDoc, "[" + input + "]", nesting));
+    }
+
+    SECTION("object") {
+      std::string input;
+      for (int i = 0; i < 2500; i++)
+        input += "{\"a\":[";
+      for (int i = 0; i < 2500; i++)
+        input += "]}";
+      SHOULD_WORK(deserializeJson(bigDoc, input, nesting));
+      REQUIRE(bigDoc["a"][0]["a"][0]["a"].is<JsonArray>());
+    }
+
+    SECTION("skipped by a filter") {
+      StaticJsonDocument<32> filter;
+      filter["b"] = true;
+      std::string input =
+          "{\"a\":" + std::string(4999, '[') + std::string(4999, ']') + "}";
+      SHOULD_WORK(deserializeJson(doc, input, nesting,
+                                  DeserializationOption::Filter(filter)));
+      REQUIRE(doc.is<JsonObject>());
+      REQUIRE(doc.size() == 0);
+    }
+  }
 }
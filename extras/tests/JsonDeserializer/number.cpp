@@ -9,6 +9,8 @@
 #include <ArduinoJson.h>
 #include <limits.h>
 #include <catch.hpp>
+#include <sstream>
+#include <string>
 
 namespace my {
 using ArduinoJson::detail::isinf;
@@ -131,3 +133,160 @@ TEST_CASE("deserialize an integer") {
     }
   }
 }
+
+TEST_CASE("deserialize a long number") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("More than 63 characters") {  // used to be truncated
+    std::string input = "0." + std::string(70, '0') + "1e72";
+    DeserializationError err = deserializeJson(doc, input);
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<double>() == Approx(10.0));
+  }
+
+  SECTION("Invalid character after many digits") {
+    std::string input = std::string(100, '1') + "..";
+    DeserializationError err = deserializeJson(doc, input);
+    REQUIRE(err == DeserializationError::InvalidInput);
+  }
+}
+
+TEST_CASE("deserializeJson() with LazyNumbers") {
+  DynamicJsonDocument doc(4096);
+  DeserializationOption::LazyNumbers lazyNumbers;
+
+  SECTION("numbers are serialized unchanged") {
+    const char* input =
+        "[18446744073709551616,-0.1000000000000000055511151231257827,"
+        "1E400,0,-0.0e+0]";
+
+    DeserializationError err = deserializeJson(doc, input, lazyNumbers);
+    std::string output;
+    serializeJson(doc, output);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(output == input);
+    REQUIRE(measureJson(doc) == output.size());
+    REQUIRE(doc.memoryUsage() ==
+            JSON_ARRAY_SIZE(5) + JSON_STRING_SIZE(20) + JSON_STRING_SIZE(37) +
+                JSON_STRING_SIZE(5) + JSON_STRING_SIZE(1) +
+                JSON_STRING_SIZE(7));
+  }
+
+  SECTION("numbers are converted on demand") {
+    deserializeJson(doc, "{\"a\":42,\"b\":-3.5,\"c\":0,\"d\":1e2}",
+                    lazyNumbers);
+
+    REQUIRE(doc["a"].as<int>() == 42);
+    REQUIRE(doc["a"].is<int>() == true);
+    REQUIRE(doc["a"].is<unsigned char>() == true);
+    REQUIRE(doc["a"].is<float>() == true);
+    REQUIRE(doc["a"].is<const char*>() == false);
+    REQUIRE(doc["b"].as<float>() == -3.5f);
+    REQUIRE(doc["b"].is<int>() == false);
+    REQUIRE(doc["b"].as<int>() == -3);
+    REQUIRE(doc["c"].as<bool>() == false);
+    REQUIRE(doc["a"].as<bool>() == true);
+    REQUIRE(doc["d"].as<double>() == 100.0);
+  }
+
+  SECTION("comparisons") {
+    deserializeJson(doc, "[42,2.5]", lazyNumbers);
+
+    REQUIRE(doc[0] == 42);
+    REQUIRE(doc[0] < 43);
+    REQUIRE(doc[1] == 2.5);
+  }
+
+  SECTION("lenient numbers are converted") {
+    deserializeJson(doc, "[+1,.5,01,NaN,-Infinity]", lazyNumbers);
+    std::string output;
+    serializeJson(doc, output);
+
+    REQUIRE(output == "[1,0.5,1,NaN,-Infinity]");
+  }
+
+  SECTION("invalid number") {
+    DeserializationError err = deserializeJson(doc, "[1-2]", lazyNumbers);
+
+    REQUIRE(err == DeserializationError::InvalidInput);
+  }
+
+  SECTION("root value") {
+    DeserializationError err = deserializeJson(doc, "12345678901234567890123",
+                                               lazyNumbers);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "12345678901234567890123");
+  }
+
+  SECTION("trailing characters after a root number") {
+    DeserializationError err = deserializeJson(doc, "42]", lazyNumbers);
+
+    REQUIRE(err == DeserializationError::InvalidInput);
+  }
+
+  SECTION("stream input") {
+    std::istringstream input("[12345678901234567890123]");
+    std::string output;
+
+    REQUIRE(deserializeJson(doc, input, lazyNumbers) ==
+            DeserializationError::Ok);
+    serializeJson(doc, output);
+
+    REQUIRE(output == "[12345678901234567890123]");
+  }
+
+  SECTION("copy to another document") {
+    deserializeJson(doc, "[123.4560]", lazyNumbers);
+    DynamicJsonDocument copy = doc;
+    doc.clear();
+    std::string output;
+    serializeJson(copy, output);
+
+    REQUIRE(output == "[123.4560]");
+  }
+
+  SECTION("garbageCollect()") {
+    deserializeJson(doc, "[1.50,2.50]", lazyNumbers);
+    doc.remove(0);
+    doc.garbageCollect();
+    std::string output;
+    serializeJson(doc, output);
+
+    REQUIRE(output == "[2.50]");
+  }
+
+  SECTION("MessagePack gets converted numbers") {
+    deserializeJson(doc, "[1,0.5]", lazyNumbers);
+    std::string output;
+    serializeMsgPack(doc, output);
+
+    REQUIRE(output == std::string("\x92\x01\xCA\x3F\x00\x00\x00", 7));
+  }
+
+  SECTION("not enough memory") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(1)> small;
+
+    DeserializationError err = deserializeJson(small, "[1234]", lazyNumbers);
+
+    REQUIRE(err == DeserializationError::NoMemory);
+  }
+
+  SECTION("in-place parsing converts the numbers") {
+    char input[] = "[1.50]";
+    deserializeJson(doc, input, lazyNumbers);
+    std::string output;
+    serializeJson(doc, output);
+
+    REQUIRE(output == "[1.5]");
+  }
+
+  SECTION("disabled") {
+    deserializeJson(doc, "[1.50]", DeserializationOption::LazyNumbers(false));
+    std::string output;
+    serializeJson(doc, output);
+
+    REQUIRE(output == "[1.5]");
+  }
+}
@@ -5,6 +5,8 @@
 #include <ArduinoJson.h>
 #include <catch.hpp>
 
+#include <string>
+
 TEST_CASE("deserialize JSON object") {
   DynamicJsonDocument doc(4096);
 
@@ -313,3 +315,65 @@ TEST_CASE("deserialize JSON object") {
     CHECK(doc.as<std::string>() == json);
   }
 }
+
+TEST_CASE("deserializeJson() with AssumeUniqueKeys") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("unique keys") {
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":1,\"b\":{\"c\":2,\"d\":3}}",
+                        DeserializationOption::AssumeUniqueKeys());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1,\"b\":{\"c\":2,\"d\":3}}");
+  }
+
+  SECTION("duplicate keys are kept") {
+    DeserializationError err = deserializeJson(
+        doc, "{\"a\":1,\"a\":2}", DeserializationOption::AssumeUniqueKeys());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1,\"a\":2}");
+    REQUIRE(doc["a"] == 1);
+  }
+
+  SECTION("disabled") {
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":1,\"a\":2}",
+                        DeserializationOption::AssumeUniqueKeys(false));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":2}");
+  }
+
+  SECTION("with a filter and a nesting limit, in any order") {
+    StaticJsonDocument<64> filter;
+    filter["a"] = true;
+
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":1,\"b\":2,\"a\":3}",
+                        DeserializationOption::NestingLimit(1),
+                        DeserializationOption::AssumeUniqueKeys(),
+                        DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1,\"a\":3}");
+  }
+
+  SECTION("many members") {
+    std::string json = "{";
+    for (int i = 0; i < 100; i++) {
+      if (i)
+        json += ',';
+      json += "\"k" + std::to_string(i) + "\":" + std::to_string(i);
+    }
+    json += "}";
+
+    DeserializationError err =
+        deserializeJson(doc, json, DeserializationOption::AssumeUniqueKeys());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.size() == 100);
+    REQUIRE(doc["k99"] == 99);
+  }
+}
@@ -0,0 +1,157 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+// Reads all the tokens and returns them as a string
+template <typename TReader>
+static std::string readAll(TReader& reader) {
+  std::ostringstream log;
+  while (reader.next()) {
+    switch (reader.type()) {
+      case JsonToken::ObjectStart:
+        log << "{";
+        break;
+      case JsonToken::ObjectEnd:
+        log << "}";
+        break;
+      case JsonToken::ArrayStart:
+        log << "[";
+        break;
+      case JsonToken::ArrayEnd:
+        log << "]";
+        break;
+      case JsonToken::Key:
+        log << reader.getString().c_str() << ":";
+        break;
+      case JsonToken::String:
+        log << "s(" << reader.getString().c_str() << ")";
+        break;
+      case JsonToken::Integer:
+        log << "i(" << reader.getInt64() << ")";
+        break;
+      case JsonToken::Float:
+        log << "f(" << reader.getFloat() << ")";
+        break;
+      case JsonToken::Boolean:
+        log << "b(" << reader.getBool() << ")";
+        break;
+      case JsonToken::Null:
+        log << "n";
+        break;
+      default:
+        log << "?";
+        break;
+    }
+  }
+  return log.str();
+}
+
+TEST_CASE("JsonReader") {
+  SECTION("all token types") {
+    auto reader = makeJsonReader(
+        "{\"s\":\"hello\",\"i\":-42,\"f\":1.5,\"b\":true,\"n\":null,\"a\":[]}");
+    REQUIRE(readAll(reader) == "{s:s(hello)i:i(-42)f:f(1.5)b:b(1)n:na:[]}");
+    REQUIRE(reader.error() == DeserializationError::Ok);
+  }
+
+  SECTION("value at the root") {
+    auto reader = makeJsonReader("42");
+    REQUIRE(readAll(reader) == "i(42)");
+    REQUIRE(reader.error() == DeserializationError::Ok);
+  }
+
+  SECTION("trailing characters") {
+    auto reader = makeJsonReader("truex");
+    REQUIRE(readAll(reader) == "b(1)");
+    REQUIRE(reader.error() == DeserializationError::InvalidInput);
+  }
+
+  SECTION("depth") {
+    auto reader = makeJsonReader("[{\"a\":[1]}]");
+    REQUIRE(reader.next());  // [
+    REQUIRE(reader.depth() == 1);
+    REQUIRE(reader.next());  // {
+    REQUIRE(reader.depth() == 2);
+    REQUIRE(reader.next());  // "a"
+    REQUIRE(reader.next());  // [
+    REQUIRE(reader.depth() == 3);
+    REQUIRE(reader.next());  // 1
+    REQUIRE(reader.depth() == 3);
+    REQUIRE(reader.next());  // ]
+    REQUIRE(reader.depth() == 2);
+  }
+
+  SECTION("skipValue() after ArrayStart") {
+    auto reader = makeJsonReader("{\"a\":[1,[2,3]],\"b\":4}");
+    REQUIRE(reader.next());  // {
+    REQUIRE(reader.next());  // "a"
+    REQUIRE(reader.next());  // [
+    REQUIRE(reader.type() == JsonToken::ArrayStart);
+    REQUIRE(reader.skipValue());
+    REQUIRE(reader.depth() == 1);
+    REQUIRE(readAll(reader) == "b:i(4)}");
+  }
+
+  SECTION("skipValue() after Key") {
+    auto reader = makeJsonReader("{\"a\":{\"x\":[1]},\"b\":4}");
+    REQUIRE(reader.next());  // {
+    REQUIRE(reader.next());  // "a"
+    REQUIRE(reader.type() == JsonToken::Key);
+    REQUIRE(reader.skipValue());
+    REQUIRE(readAll(reader) == "b:i(4)}");
+  }
+
+  SECTION("std::istream") {
+    std::istringstream input("[\"hello\",{}]");
+    auto reader = makeJsonReader(input);
+    REQUIRE(readAll(reader) == "[s(hello){}]");
+  }
+
+  SECTION("sized input") {
+    auto reader = makeJsonReader("[1,2]", 4);
+    REQUIRE(readAll(reader) == "[i(1)i(2)");
+    REQUIRE(reader.error() == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("invalid input") {
+    auto reader = makeJsonReader("[1;2]");
+    REQUIRE(readAll(reader) == "[i(1)");
+    REQUIRE(reader.error() == DeserializationError::InvalidInput);
+    REQUIRE(reader.next() == false);
+  }
+
+  SECTION("empty input") {
+    auto reader = makeJsonReader("");
+    REQUIRE(reader.next() == false);
+    REQUIRE(reader.error() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("nesting limit") {
+    auto reader =
+        makeJsonReader("[[]]", DeserializationOption::NestingLimit(1));
+    REQUIRE(readAll(reader) == "[");
+    REQUIRE(reader.error() == DeserializationError::TooDeep);
+  }
+
+  SECTION("nesting limit above the default") {
+    std::string input = std::string(150, '[') + std::string(150, ']');
+    auto reader =
+        makeJsonReader(input, DeserializationOption::NestingLimit(200));
+    REQUIRE(readAll(reader) == input);
+    REQUIRE(reader.error() == DeserializationError::Ok);
+  }
+
+  SECTION("string longer than the buffer") {
+    std::string input =
+        "[\"" + std::string(ARDUINOJSON_HANDLER_BUFFER_SIZE, 'x') + "\"]";
+    auto reader = makeJsonReader(input);
+    REQUIRE(readAll(reader) == "[");
+    REQUIRE(reader.error() == DeserializationError::StringTooLong);
+  }
+}
@@ -0,0 +1,143 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_DECODE_UNICODE 1
+#define ARDUINOJSON_ENABLE_COMMENTS 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+// Feeds the input in chunks of the specified size
+static DeserializationError feedInChunks(JsonStreamParser& parser,
+                                         const std::string& input,
+                                         size_t chunkSize) {
+  DeserializationError err = DeserializationError::NeedMoreData;
+  for (size_t i = 0; i < input.size(); i += chunkSize) {
+    std::string chunk = input.substr(i, chunkSize);
+    err = parser.feed(chunk.data(), chunk.size());
+    if (err != DeserializationError::NeedMoreData)
+      return err;
+  }
+  return parser.finish();
+}
+
+TEST_CASE("JsonStreamParser") {
+  DynamicJsonDocument doc(4096);
+  JsonStreamParser parser(doc);
+
+  SECTION("gives the same result as deserializeJson() for all chunk sizes") {
+    const char* inputs[] = {
+        "{\"hello\":\"world\",\"answer\":42,\"list\":[1,2.5,-3e2,true,false]}",
+        " [ [ ] , { } , null , \"\" , 'single' ] ",
+        "{key:\"value\",\"nested\":{\"a\":[{\"b\":{}}]}}",
+        "\"esc\\\"ape\\\\ \\/ \\b\\f\\n\\r\\t \\u00e9 \\ud83d\\udda4\"",
+        "[/* comment */ 1, // line comment\n 2]",
+        "{\"dup\":1,\"dup\":2}",
+        "\"a very long string that is much longer than the smallest chunks\"",
+        "-123.456e-7",
+        "true",
+    };
+
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+      std::string input = inputs[i];
+      DynamicJsonDocument expected(4096);
+      REQUIRE(deserializeJson(expected, input) == DeserializationError::Ok);
+
+      for (size_t chunkSize = 1; chunkSize <= input.size(); chunkSize++) {
+        CAPTURE(input);
+        CAPTURE(chunkSize);
+        parser.reset();
+        REQUIRE(feedInChunks(parser, input, chunkSize) ==
+                DeserializationError::Ok);
+        REQUIRE(doc == expected);
+      }
+    }
+  }
+
+  SECTION("returns NeedMoreData until the document is complete") {
+    REQUIRE(parser.feed("{\"a\":[1,", 8) == DeserializationError::NeedMoreData);
+    REQUIRE(parser.consumed() == 8);
+    REQUIRE(parser.feed("2]}", 3) == DeserializationError::Ok);
+    REQUIRE(doc["a"][1] == 2);
+  }
+
+  SECTION("accepts spaces and comments after the document") {
+    REQUIRE(parser.feed("[1] ", 4) == DeserializationError::Ok);
+    REQUIRE(parser.feed("/* end */\n", 10) == DeserializationError::Ok);
+    REQUIRE(parser.finish() == DeserializationError::Ok);
+    REQUIRE(doc[0] == 1);
+
+    parser.reset();
+    REQUIRE(feedInChunks(parser, "42 // answer", 5) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.as<int>() == 42);
+  }
+
+  SECTION("rejects the characters after the document") {
+    REQUIRE(parser.feed("[1] [2]", 7) == DeserializationError::InvalidInput);
+    REQUIRE(parser.consumed() == 4);
+
+    parser.reset();
+    REQUIRE(parser.feed("[1]", 3) == DeserializationError::Ok);
+    REQUIRE(parser.feed(" x", 2) == DeserializationError::InvalidInput);
+
+    parser.reset();
+    REQUIRE(feedInChunks(parser, "123x", 1) ==
+            DeserializationError::InvalidInput);
+
+    parser.reset();
+    REQUIRE(feedInChunks(parser, "truex", 3) ==
+            DeserializationError::InvalidInput);
+  }
+
+  SECTION("a number at the root needs finish()") {
+    REQUIRE(parser.feed("42", 2) == DeserializationError::NeedMoreData);
+    REQUIRE(parser.finish() == DeserializationError::Ok);
+    REQUIRE(doc.as<int>() == 42);
+  }
+
+  SECTION("finish() reports incomplete and empty input") {
+    REQUIRE(parser.feed("[1", 2) == DeserializationError::NeedMoreData);
+    REQUIRE(parser.finish() == DeserializationError::IncompleteInput);
+
+    parser.reset();
+    REQUIRE(parser.feed(" ", 1) == DeserializationError::NeedMoreData);
+    REQUIRE(parser.finish() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("invalid input") {
+    REQUIRE(parser.feed("[1,]", 4) == DeserializationError::InvalidInput);
+    // the error sticks until reset()
+    REQUIRE(parser.feed("[]", 2) == DeserializationError::InvalidInput);
+  }
+
+  SECTION("long number") {
+    std::string input = "[0." + std::string(80, '0') + "1]";
+    DynamicJsonDocument expected(4096);
+    REQUIRE(deserializeJson(expected, input) == DeserializationError::Ok);
+
+    REQUIRE(feedInChunks(parser, input, 7) == DeserializationError::Ok);
+    REQUIRE(doc == expected);
+    REQUIRE(doc[0].as<double>() > 0);
+  }
+
+  SECTION("nesting limit") {
+    JsonStreamParser limited(doc, DeserializationOption::NestingLimit(1));
+    REQUIRE(limited.feed("[[]]", 4) == DeserializationError::TooDeep);
+  }
+
+  SECTION("nesting limit above the default") {
+    std::string input = std::string(150, '[') + std::string(150, ']');
+    DynamicJsonDocument bigDoc(JSON_ARRAY_SIZE(1) * 150);
+    JsonStreamParser deep(bigDoc, DeserializationOption::NestingLimit(200));
+    REQUIRE(feedInChunks(deep, input, 4) == DeserializationError::Ok);
+  }
+
+  SECTION("not enough memory") {
+    DynamicJsonDocument small(JSON_ARRAY_SIZE(1));
+    JsonStreamParser smallParser(small);
+    REQUIRE(smallParser.feed("[1,2]", 5) == DeserializationError::NoMemory);
+  }
+}
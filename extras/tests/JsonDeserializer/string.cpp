@@ -6,6 +6,10 @@
 #include <ArduinoJson.h>
 #include <catch.hpp>
 
+#include <sstream>
+#include <string>
+#include <vector>
+
 TEST_CASE("Valid JSON strings value") {
   struct TestCase {
     const char* input;
@@ -130,3 +134,238 @@ TEST_CASE("Empty memory pool") {
     REQUIRE(deserializeJson(doc, empty) == DeserializationError::Ok);
   }
 }
+
+TEST_CASE("Long JSON strings") {
+  DynamicJsonDocument doc(4096);
+
+  // escape sequences at every offset, to test all positions in a word
+  for (size_t i = 0; i < 20; i++) {
+    std::string expected = std::string(i, 'a') + "\"b\\c" + std::string(i, 'd');
+    std::string input = "[\"" + std::string(i, 'a') + "\\\"b\\\\c" +
+                        std::string(i, 'd') + "\"]";
+    CAPTURE(input);
+
+    REQUIRE(deserializeJson(doc, input.c_str()) == DeserializationError::Ok);
+    REQUIRE(doc[0] == expected);
+
+    std::vector<char> buffer(input.begin(), input.end());
+    buffer.push_back(0);
+    REQUIRE(deserializeJson(doc, buffer.data()) == DeserializationError::Ok);
+    REQUIRE(doc[0] == expected);
+
+    std::istringstream stream(input);
+    REQUIRE(deserializeJson(doc, stream) == DeserializationError::Ok);
+    REQUIRE(doc[0] == expected);
+  }
+
+  SECTION("unterminated") {
+    std::string input = "\"" + std::string(100, 'a');
+    REQUIRE(deserializeJson(doc, input.c_str()) ==
+            DeserializationError::IncompleteInput);
+    REQUIRE(deserializeJson(doc, input.c_str(), 50) ==
+            DeserializationError::IncompleteInput);
+  }
+
+  SECTION("too long for the pool") {
+    DynamicJsonDocument small(JSON_ARRAY_SIZE(1) + 16);
+    std::string input = "[\"" + std::string(100, 'a') + "\"]";
+    REQUIRE(deserializeJson(small, input.c_str()) ==
+            DeserializationError::NoMemory);
+  }
+}
+
+TEST_CASE("deserializeJson() with ZeroCopy") {
+  DynamicJsonDocument doc(1024);
+  DeserializationOption::ZeroCopy zeroCopy;
+
+  SECTION("strings without escape sequences point to the input") {
+    const char* input = "{\"hello\":\"world\",\"list\":['a','b']}";
+
+    DeserializationError err = deserializeJson(doc, input, zeroCopy);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["hello"].as<JsonString>().c_str() == input + 10);
+    REQUIRE(doc["hello"].as<JsonString>().size() == 5);
+    REQUIRE(doc["hello"] == "world");
+    REQUIRE(doc["list"][1].as<std::string>() == "b");
+    REQUIRE(doc.as<std::string>() ==
+            "{\"hello\":\"world\",\"list\":[\"a\",\"b\"]}");
+    // only the keys are in the pool
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(2) +
+                                     JSON_STRING_SIZE(5) + JSON_STRING_SIZE(4));
+  }
+
+  SECTION("strings with escape sequences are copied") {
+    const char* input = "[\"a\\nb\",\"\"]";
+
+    DeserializationError err = deserializeJson(doc, input, zeroCopy);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "a\nb");
+    REQUIRE(doc[1] == "");
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2) + JSON_STRING_SIZE(3));
+  }
+
+  SECTION("std::string") {
+    std::string input = "[\"abc\"]";
+
+    DeserializationError err = deserializeJson(doc, input, zeroCopy);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0].as<JsonString>().c_str() == input.c_str() + 2);
+  }
+
+  SECTION("bounded input") {
+    const char* input = "[\"abc\"]\"def\"";
+
+    REQUIRE(deserializeJson(doc, input, 7, zeroCopy) ==
+            DeserializationError::Ok);
+    REQUIRE(doc[0] == "abc");
+
+    REQUIRE(deserializeJson(doc, input + 7, 4, zeroCopy) ==
+            DeserializationError::IncompleteInput);
+  }
+
+  SECTION("stream input is copied") {
+    std::istringstream input("[\"abc\"]");
+
+    DeserializationError err = deserializeJson(doc, input, zeroCopy);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "abc");
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1) + JSON_STRING_SIZE(3));
+  }
+
+  SECTION("linked strings are not C strings") {
+    deserializeJson(doc, "[\"abc\",\"def\"]", zeroCopy);
+    JsonVariantConst first = doc[0];
+
+    REQUIRE(first.as<const char*>() == nullptr);
+    REQUIRE(first.is<const char*>() == false);
+    REQUIRE(first.is<JsonString>() == true);
+    REQUIRE(first.as<std::string>() == "abc");
+    REQUIRE((first | "default") == std::string("default"));
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2));
+  }
+
+  SECTION("as<const char*>() copies the linked string") {
+    const char* input = "[\"abc\",\"def\"]";
+    deserializeJson(doc, input, zeroCopy);
+
+    const char* s = doc[0].as<const char*>();
+    REQUIRE(s == std::string("abc"));
+    REQUIRE(s != input + 2);
+    REQUIRE(doc[0].is<const char*>() == true);
+    REQUIRE(doc[0].as<const char*>() == s);
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2) + JSON_STRING_SIZE(3));
+
+    REQUIRE((doc[1] | "default") == std::string("def"));
+    REQUIRE(doc.as<std::string>() == "[\"abc\",\"def\"]");
+  }
+
+  SECTION("as<const char*>() returns null if the pool is full") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(1)> small;
+    deserializeJson(small, "[\"abc\"]", zeroCopy);
+
+    REQUIRE(small[0].as<const char*>() == nullptr);
+    REQUIRE(small[0].as<std::string>() == "abc");
+  }
+
+  SECTION("disabled") {
+    deserializeJson(doc, "[\"abc\"]", DeserializationOption::ZeroCopy(false));
+
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1) + JSON_STRING_SIZE(3));
+  }
+}
+
+TEST_CASE("deserializeJson() with ValidateUtf8") {
+  DynamicJsonDocument doc(4096);
+  DeserializationOption::ValidateUtf8 validate;
+
+  SECTION("valid characters") {
+    // U+00E9, U+20AC, U+1F600, and the bounds of each length
+    const char* input =
+        "[\"\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\","
+        "\"\xC2\x80\xDF\xBF\xE0\xA0\x80\xEF\xBF\xBF\xF4\x8F\xBF\xBF\"]";
+
+    DeserializationError err = deserializeJson(doc, input, validate);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+  }
+
+  SECTION("invalid sequences") {
+    const char* testCases[] = {
+        "\"\x80\"",              // lone continuation byte
+        "\"\xC0\xAF\"",          // overlong 2-byte sequence
+        "\"\xE0\x80\xAF\"",      // overlong 3-byte sequence
+        "\"\xF0\x80\x80\xAF\"",  // overlong 4-byte sequence
+        "\"\xED\xA0\x80\"",      // surrogate
+        "\"\xF4\x90\x80\x80\"",  // above U+10FFFF
+        "\"\xF8\x88\x80\x80\"",  // 5-byte sequence
+        "\"\xC3\"",              // truncated sequence
+        "\"\xE2\x82\"",          // truncated sequence
+        "\"\xC3\\n\"",           // interrupted by an escape sequence
+        "\"\xC3x\"",             // interrupted by an ASCII character
+    };
+
+    for (const char* input : testCases) {
+      CAPTURE(input);
+      REQUIRE(deserializeJson(doc, input, validate) ==
+              DeserializationError::InvalidUtf8);
+    }
+  }
+
+  SECTION("invalid byte after a long ASCII run") {
+    std::string input = "\"" + std::string(100, 'a') + "\xFF\"";
+
+    REQUIRE(deserializeJson(doc, input, validate) ==
+            DeserializationError::InvalidUtf8);
+  }
+
+  SECTION("escaped characters are valid") {
+    DeserializationError err =
+        deserializeJson(doc, "\"\\u00e9\\t\"", validate);
+
+    REQUIRE(err == DeserializationError::Ok);
+  }
+
+  SECTION("key") {
+    REQUIRE(deserializeJson(doc, "{\"\xC3\":1}", validate) ==
+            DeserializationError::InvalidUtf8);
+  }
+
+  SECTION("filtered-out string") {
+    StaticJsonDocument<64> filter;
+    filter["a"] = true;
+
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":1,\"b\":\"\xC3\"}",
+                        DeserializationOption::Filter(filter), validate);
+
+    REQUIRE(err == DeserializationError::InvalidUtf8);
+  }
+
+  SECTION("stream input") {
+    std::istringstream input("[\"\xC3\xA9\",\"\xE2\x82\"]");
+
+    REQUIRE(deserializeJson(doc, input, validate) ==
+            DeserializationError::InvalidUtf8);
+  }
+
+  SECTION("with ZeroCopy") {
+    DeserializationOption::ZeroCopy zeroCopy;
+
+    REQUIRE(deserializeJson(doc, "[\"\xC3\xA9\"]", zeroCopy, validate) ==
+            DeserializationError::Ok);
+    REQUIRE(deserializeJson(doc, "[\"\xC3\"]", zeroCopy, validate) ==
+            DeserializationError::InvalidUtf8);
+  }
+
+  SECTION("disabled") {
+    DeserializationError err = deserializeJson(
+        doc, "\"\xC3\"", DeserializationOption::ValidateUtf8(false));
+
+    REQUIRE(err == DeserializationError::Ok);
+  }
+}
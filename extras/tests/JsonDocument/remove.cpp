@@ -49,4 +49,33 @@ TEST_CASE("JsonDocument::remove()") {
     REQUIRE(doc.as<std::string>() == "{\"a\":1}");
   }
 #endif
+
+  SECTION("the removed element remains readable") {
+    JsonObject obj = doc.createNestedObject();
+    obj["x"] = 1;
+
+    doc.remove(0);
+    doc.add(8);
+    doc.add(9);
+
+    std::string json;
+    serializeJson(obj, json);
+    REQUIRE(json == "{\"x\":1}");
+    REQUIRE(doc.as<std::string>() == "[8,9]");
+  }
+
+  SECTION("keeps the slots of a shallow copy") {
+    doc["a"][0] = 1;
+    doc["a"][1] = 2;
+    doc["b"].shallowCopy(doc["a"]);
+
+    doc["b"].as<JsonArray>().clear();
+    doc.remove("b");
+    doc["c"] = 42;
+    doc["d"] = 43;
+    doc["e"] = 44;
+
+    REQUIRE(doc.as<std::string>() ==
+            "{\"a\":[1,2],\"c\":42,\"d\":43,\"e\":44}");
+  }
 }
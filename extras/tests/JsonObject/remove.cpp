@@ -58,6 +58,14 @@ TEST_CASE("JsonObject::remove()") {
     }
   }
 
+  SECTION("remove every member in a range-based for loop") {
+    for (JsonPair kv : obj)
+      obj.remove(kv.key());
+
+    serializeJson(obj, result);
+    REQUIRE("{}" == result);
+  }
+
 #ifdef HAS_VARIABLE_LENGTH_ARRAY
   SECTION("key is a vla") {
     size_t i = 16;
@@ -72,6 +72,21 @@ TEST_CASE("JsonVariant::shallowCopy()") {
     CHECK(unbound.size() == 0);
   }
 
+  SECTION("clearing the copy keeps the original") {
+    doc2["a"] = 1;
+    doc2["b"] = 2;
+
+    variant.shallowCopy(doc2);
+
+    CHECK(variant.is<JsonObject>() == true);
+    variant.as<JsonObject>().clear();
+    doc2["c"] = 3;
+    doc2["d"] = 4;
+
+    CHECK(variant.size() == 0);
+    CHECK(doc2.as<std::string>() == "{\"a\":1,\"b\":2,\"c\":3,\"d\":4}");
+  }
+
   SECTION("preserves owned key bit") {
     doc2.set(42);
 
@@ -44,6 +44,30 @@ TEST_CASE("StringCopier") {
     REQUIRE(pool.overflowed() == false);
   }
 
+  SECTION("Appends several characters at once") {
+    MemoryPool pool(buffer, addPadding(JSON_STRING_SIZE(10)));
+    StringCopier str(&pool);
+
+    str.startString();
+    str.append('h');
+    str.append("elloworld", 4);
+    str.append("", 0);
+
+    REQUIRE(str.isValid() == true);
+    REQUIRE(str.str() == "hello");
+  }
+
+  SECTION("Overflows when several characters don't fit") {
+    MemoryPool pool(buffer, sizeof(void*));
+    StringCopier str(&pool);
+
+    str.startString();
+    str.append("hello world!", 12);
+
+    REQUIRE(str.isValid() == false);
+    REQUIRE(pool.overflowed() == true);
+  }
+
   SECTION("Works when memory pool is 0 bytes") {
     MemoryPool pool(buffer, 0);
     StringCopier str(&pool);
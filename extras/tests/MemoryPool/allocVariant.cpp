@@ -47,4 +47,47 @@ TEST_CASE("MemoryPool::allocVariant()") {
 
     REQUIRE(pool.allocVariant() == 0);
   }
+
+  SECTION("Reuses the released slots first") {
+    MemoryPool pool(buffer, sizeof(buffer));
+
+    VariantSlot* s1 = pool.allocVariant();
+    VariantSlot* s2 = pool.allocVariant();
+    pool.freeVariant(s1);
+    pool.freeVariant(s2);
+
+    REQUIRE(pool.allocVariant() == s2);
+    REQUIRE(pool.allocVariant() == s1);
+    REQUIRE(pool.size() == 2 * sizeof(VariantSlot));
+  }
+
+  SECTION("Reuses a released slot when the pool is full") {
+    MemoryPool pool(buffer, sizeof(VariantSlot));
+
+    VariantSlot* s1 = pool.allocVariant();
+    pool.freeVariant(s1);
+
+    REQUIRE(pool.allocVariant() == s1);
+    REQUIRE(pool.allocVariant() == 0);
+  }
+
+  SECTION("Ignores the slots of other pools") {
+    MemoryPool pool(buffer, sizeof(buffer));
+    VariantSlot other;
+
+    pool.freeVariant(&other);
+
+    REQUIRE(pool.allocVariant() != &other);
+  }
+
+  SECTION("Forgets the released slots on clear()") {
+    MemoryPool pool(buffer, sizeof(buffer));
+
+    VariantSlot* s1 = pool.allocVariant();
+    VariantSlot* s2 = pool.allocVariant();
+    pool.freeVariant(s2);
+    pool.clear();
+
+    REQUIRE(pool.allocVariant() == s1);
+  }
 }
@@ -6,7 +6,9 @@
 #include <ArduinoJson.hpp>
 #include <catch.hpp>
 
+#include <list>
 #include <sstream>
+#include <vector>
 
 using namespace ArduinoJson::detail;
 
@@ -49,6 +51,34 @@ TEST_CASE("Reader<std::istringstream>") {
     REQUIRE(buffer[5] == 'F');
     REQUIRE(buffer[6] == 'g');
   }
+
+  SECTION("read() leaves the remaining bytes in the stream") {
+    std::istringstream src("ABC");
+    Reader<std::istringstream> reader(src);
+
+    REQUIRE(reader.read() == 'A');
+    REQUIRE(src.get() == 'B');
+    REQUIRE(reader.read() == 'C');
+  }
+
+  SECTION("read() sets eofbit and failbit at the end of the stream") {
+    std::istringstream src("A");
+    Reader<std::istringstream> reader(src);
+
+    REQUIRE(reader.read() == 'A');
+    REQUIRE(src.good() == true);
+    REQUIRE(reader.read() == -1);
+    REQUIRE(src.eof() == true);
+    REQUIRE(src.fail() == true);
+  }
+
+  SECTION("read() returns -1 when the stream is in a failed state") {
+    std::istringstream src("ABC");
+    src.setstate(std::ios::failbit);
+    Reader<std::istringstream> reader(src);
+
+    REQUIRE(reader.read() == -1);
+  }
 }
 
 TEST_CASE("BoundedReader<const char*>") {
@@ -225,3 +255,25 @@ TEST_CASE("Reader<Stream>") {
     REQUIRE(buffer[6] == 'g');
   }
 }
+
+TEST_CASE("IsContiguousReader") {
+  CHECK(IsContiguousReader<Reader<const char*>>::value == true);
+  CHECK(IsContiguousReader<Reader<char*>>::value == true);
+  CHECK(IsContiguousReader<BoundedReader<const char*>>::value == true);
+  CHECK(IsContiguousReader<BoundedReader<unsigned char*>>::value == true);
+  CHECK(IsContiguousReader<Reader<std::istringstream>>::value == false);
+  CHECK(IsContiguousReader<Reader<std::string>>::value == true);
+  CHECK(IsContiguousReader<Reader<std::vector<char>>>::value == true);
+  CHECK(IsContiguousReader<Reader<std::list<char>>>::value == false);
+  CHECK(IsContiguousReader<Reader<StreamStub>>::value == false);
+
+  SECTION("Reader<const char*> stops at the terminator") {
+    Reader<const char*> reader("ABC\0DEF");
+    REQUIRE(reader.end() - reader.begin() == 3);
+  }
+
+  SECTION("BoundedReader<const char*> stops at the size") {
+    BoundedReader<const char*> reader("ABC\0DEF", 7);
+    REQUIRE(reader.end() - reader.begin() == 7);
+  }
+}
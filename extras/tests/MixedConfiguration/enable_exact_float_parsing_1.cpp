@@ -0,0 +1,18 @@
+#define ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING == 1") {
+  DynamicJsonDocument doc(4096);
+
+  DeserializationError err = deserializeJson(
+      doc, "[3.14,-1.7976931348623157e+308,1e-300,1e309,5e-324]");
+
+  REQUIRE(err == DeserializationError::Ok);
+  REQUIRE(doc[0].as<double>() == 3.14);
+  REQUIRE(doc[1].as<double>() == -1.7976931348623157e+308);
+  REQUIRE(doc[2].as<double>() == 1e-300);
+  REQUIRE(doc[3].as<double>() > 1.7976931348623157e+308);
+  REQUIRE(doc[4].as<double>() == 5e-324);
+}
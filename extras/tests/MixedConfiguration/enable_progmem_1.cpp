@@ -188,4 +188,7 @@ TEST_CASE("DeserializationError::f_str()") {
   TEST_STRINGIFICATION(InvalidInput);
   TEST_STRINGIFICATION(NoMemory);
   TEST_STRINGIFICATION(TooDeep);
+  TEST_STRINGIFICATION(NeedMoreData);
+  TEST_STRINGIFICATION(InvalidUtf8);
+  TEST_STRINGIFICATION(StringTooLong);
 }
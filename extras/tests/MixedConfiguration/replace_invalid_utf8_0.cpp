@@ -0,0 +1,15 @@
+#define ARDUINOJSON_REPLACE_INVALID_UTF8 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_REPLACE_INVALID_UTF8 == 0") {
+  DynamicJsonDocument doc(2048);
+  doc["a"] = "\xC3(";
+
+  std::string output;
+  serializeJson(doc, output);
+
+  REQUIRE(output == "{\"a\":\"\xC3(\"}");
+}
@@ -0,0 +1,40 @@
+#define ARDUINOJSON_VERSION_NAMESPACE ReplaceInvalidUtf8
+#define ARDUINOJSON_REPLACE_INVALID_UTF8 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_REPLACE_INVALID_UTF8 == 1") {
+  DynamicJsonDocument doc(2048);
+
+  SECTION("valid characters are unchanged") {
+    doc["\xC3\xA9"] = "\xE2\x82\xAC\xF0\x9F\x98\x80\n";
+
+    std::string output;
+    serializeJson(doc, output);
+
+    REQUIRE(output == "{\"\xC3\xA9\":\"\xE2\x82\xAC\xF0\x9F\x98\x80\\n\"}");
+  }
+
+  SECTION("invalid bytes are replaced") {
+    doc["a"] = "\xC3(\xFF";
+    doc["\xED\xA0\x80"] = serialized("raw");
+
+    std::string output;
+    serializeJson(doc, output);
+
+    REQUIRE(output ==
+            "{\"a\":\"\\ufffd(\\ufffd\",\"\\ufffd\\ufffd\\ufffd\":raw}");
+    REQUIRE(measureJson(doc) == output.size());
+  }
+
+  SECTION("truncated sequence at the end") {
+    doc.set(std::string("\xE2\x82"));
+
+    std::string output;
+    serializeJson(doc, output);
+
+    REQUIRE(output == "\"\\ufffd\\ufffd\"");
+  }
+}
@@ -0,0 +1,103 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_VERSION_NAMESPACE StringIndexSize
+#define ARDUINOJSON_ENABLE_STRING_DEDUPLICATION 1
+#define ARDUINOJSON_STRING_INDEX_SIZE 16
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+static const char* firstKey(JsonVariantConst object) {
+  return object.as<JsonObjectConst>().begin()->key().c_str();
+}
+
+TEST_CASE("ARDUINOJSON_STRING_INDEX_SIZE == 16") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("deduplicates values") {
+    deserializeJson(doc, "[\"example\",\"example\"]");
+
+    CHECK(doc.memoryUsage() == JSON_ARRAY_SIZE(2) + 8);
+    CHECK(doc[0].as<const char*>() == doc[1].as<const char*>());
+  }
+
+  SECTION("deduplicates keys") {
+    deserializeJson(doc, "[{\"example\":1},{\"example\":2}]");
+
+    CHECK(doc.memoryUsage() ==
+          2 * JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(2) + 8);
+    CHECK(firstKey(doc[0]) == firstKey(doc[1]));
+  }
+
+  SECTION("deduplicates strings saved with JsonDocument") {
+    doc.add(std::string("example"));
+    doc.add(std::string("example"));
+
+    CHECK(doc.memoryUsage() == JSON_ARRAY_SIZE(2) + 8);
+  }
+
+  SECTION("doesn't confuse strings with the same length") {
+    deserializeJson(doc, "[\"abc\",\"abd\",\"abc\"]");
+
+    CHECK(doc.memoryUsage() == JSON_ARRAY_SIZE(3) + 8);
+    CHECK(doc[2] == "abc");
+  }
+
+  SECTION("still deduplicates when the index is full") {
+    std::string input = "[";
+    for (int i = 0; i < 40; i++)
+      input += "\"s" + std::to_string(i) + "\",";
+    input += "\"s0\",\"s39\"]";
+
+    deserializeJson(doc, input);
+
+    CHECK(doc[40].as<const char*>() == doc[0].as<const char*>());
+    CHECK(doc[41].as<const char*>() == doc[39].as<const char*>());
+  }
+
+  SECTION("forgets the strings when the document is cleared") {
+    deserializeJson(doc, "[\"example\"]");
+    deserializeJson(doc, "[\"other\",\"example\"]");
+
+    CHECK(doc.memoryUsage() == JSON_ARRAY_SIZE(2) + 6 + 8);
+    CHECK(doc[1] == "example");
+  }
+
+  SECTION("forgets the strings released by ElementFilter") {
+    DynamicJsonDocument filter(128);
+    filter[0] = true;
+    DeserializationOption::ElementFilter elements(filter);
+    elements.where([](JsonVariantConst e) { return e != "drop"; });
+
+    deserializeJson(doc, "[\"drop\",\"keep\",\"drop\",\"kept\",\"keep\"]",
+                    elements);
+
+    CHECK(doc.as<std::string>() == "[\"keep\",\"kept\",\"keep\"]");
+    CHECK(doc.memoryUsage() == JSON_ARRAY_SIZE(3) + 5 + 5);
+    CHECK(doc[0].as<const char*>() == doc[2].as<const char*>());
+  }
+
+  SECTION("survives garbageCollect()") {
+    deserializeJson(doc, "[\"example\"]");
+    doc.garbageCollect();
+
+    doc.add(std::string("example"));
+
+    CHECK(doc[0].as<const char*>() == doc[1].as<const char*>());
+  }
+
+  SECTION("measureDeserializeJson() uses the index too") {
+    std::string input = "[";
+    for (int i = 0; i < 40; i++)
+      input += "{\"key" + std::to_string(i % 5) + "\":\"value\"},";
+    input += "\"value\"]";
+
+    size_t capacity = measureDeserializeJson(input);
+    deserializeJson(doc, input);
+
+    CHECK(capacity == doc.memoryUsage());
+  }
+}
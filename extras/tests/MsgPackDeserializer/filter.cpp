@@ -1043,6 +1043,23 @@ TEST_CASE("Zero-copy mode") {  // issue #1697
   CHECK(doc.as<std::string>() == "{\"include\":1}");
 }
 
+TEST_CASE("deserializeMsgPack() with a CompiledFilter") {
+  StaticJsonDocument<256> filter;
+  filter["include"] = true;
+  filter["list"][0]["id"] = true;
+  DeserializationOption::CompiledFilter<8> compiled(filter);
+
+  StaticJsonDocument<256> doc;
+  DeserializationError err = deserializeMsgPack(
+      doc,
+      "\x83\xA7include\x01\xA6ignore\x02\xA4list\x91\x82\xA2id\x03\xA1x"
+      "\x04",
+      32, compiled);
+
+  CHECK(err == DeserializationError::Ok);
+  CHECK(doc.as<std::string>() == "{\"include\":1,\"list\":[{\"id\":3}]}");
+}
+
 TEST_CASE("Overloads") {
   StaticJsonDocument<256> doc;
   StaticJsonDocument<256> filter;
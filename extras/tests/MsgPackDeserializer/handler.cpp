@@ -0,0 +1,124 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+// Records the events in a string
+struct SpyingHandler {
+  std::ostringstream log;
+  std::string skippedKey;
+  bool skipObjects = false;
+
+  bool onObjectStart() {
+    log << "{";
+    return !skipObjects;
+  }
+
+  void onObjectEnd() {
+    log << "}";
+  }
+
+  bool onKey(JsonString key) {
+    log << key.c_str() << ":";
+    return skippedKey != key.c_str();
+  }
+
+  bool onArrayStart() {
+    log << "[";
+    return true;
+  }
+
+  void onArrayEnd() {
+    log << "]";
+  }
+
+  void onString(JsonString value) {
+    log << "s(" << value.c_str() << ")";
+  }
+
+  void onInteger(JsonInteger value) {
+    log << "i(" << value << ")";
+  }
+
+  void onInteger(JsonUInt value) {
+    log << "u(" << value << ")";
+  }
+
+  void onFloat(JsonFloat value) {
+    log << "f(" << value << ")";
+  }
+
+  void onBool(bool value) {
+    log << "b(" << value << ")";
+  }
+
+  void onNull() {
+    log << "n";
+  }
+};
+
+TEST_CASE("deserializeMsgPack(handler)") {
+  SpyingHandler handler;
+
+  SECTION("scalars") {
+    std::string input(
+        "\x96\xA5hello\xFF\xCC\x2A\xCA\x3F\xC0\x00\x00\xC3\xC0", 17);
+    REQUIRE(deserializeMsgPack(handler, input) == DeserializationError::Ok);
+    REQUIRE(handler.log.str() == "[s(hello)i(-1)u(42)f(1.5)b(1)n]");
+  }
+
+  SECTION("nested") {
+    REQUIRE(deserializeMsgPack(handler,
+                               "\x82\xA1\x61\x81\xA1\x62\x90\xA1\x63\x80") ==
+            DeserializationError::Ok);
+    REQUIRE(handler.log.str() == "{a:{b:[]}c:{}}");
+  }
+
+  SECTION("onKey() returns false") {
+    handler.skippedKey = "b";
+    REQUIRE(deserializeMsgPack(handler,
+                               "\x83\xA1\x61\x01\xA1\x62\x81\xA1\x78\x91\x02"
+                               "\xA1\x63\x03") == DeserializationError::Ok);
+    REQUIRE(handler.log.str() == "{a:i(1)b:c:i(3)}");
+  }
+
+  SECTION("onObjectStart() returns false") {
+    handler.skipObjects = true;
+    REQUIRE(deserializeMsgPack(handler, "\x92\x81\xA1\x61\x91\x01\x02") ==
+            DeserializationError::Ok);
+    REQUIRE(handler.log.str() == "[{i(2)]");
+  }
+
+  SECTION("std::istream") {
+    std::istringstream input("\x91\xA5hello");
+    REQUIRE(deserializeMsgPack(handler, input) == DeserializationError::Ok);
+    REQUIRE(handler.log.str() == "[s(hello)]");
+  }
+
+  SECTION("incomplete input") {
+    REQUIRE(deserializeMsgPack(handler, "\x92\x01", 2) ==
+            DeserializationError::IncompleteInput);
+  }
+
+  SECTION("empty input") {
+    REQUIRE(deserializeMsgPack(handler, "", 0) ==
+            DeserializationError::EmptyInput);
+  }
+
+  SECTION("nesting limit") {
+    REQUIRE(deserializeMsgPack(handler, "\x91\x90",
+                               DeserializationOption::NestingLimit(1)) ==
+            DeserializationError::TooDeep);
+  }
+
+  SECTION("string longer than the buffer") {
+    std::istringstream input("\xDA\x01\x2C" + std::string(300, 'x'));
+    REQUIRE(deserializeMsgPack(handler, input) ==
+            DeserializationError::StringTooLong);
+  }
+}
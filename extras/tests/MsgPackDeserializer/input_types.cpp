@@ -47,6 +47,18 @@ TEST_CASE("deserializeMsgPack(const std::string&)") {
   }
 }
 
+TEST_CASE("deserializeMsgPack(inSitu(...))") {
+  DynamicJsonDocument doc(4096);
+  std::string input("\x92\xA5hello\xA5world", 13);
+
+  DeserializationError err = deserializeMsgPack(doc, inSitu(input));
+
+  REQUIRE(err == DeserializationError::Ok);
+  REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2));
+  REQUIRE(doc[0] == "hello");
+  REQUIRE(doc[1] == "world");
+}
+
 TEST_CASE("deserializeMsgPack(std::istream&)") {
   DynamicJsonDocument doc(4096);
 
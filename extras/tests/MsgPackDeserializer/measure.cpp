@@ -0,0 +1,46 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+TEST_CASE("measureDeserializeMsgPack()") {
+  SECTION("matches memoryUsage()") {
+    // {"a":1,"b":["x","x"],"c":{"d":"hello"}}
+    std::string input(
+        "\x83\xA1\x61\x01\xA1\x62\x92\xA1\x78\xA1\x78\xA1\x63\x81\xA1\x64"
+        "\xA5hello");
+    DynamicJsonDocument doc(1024);
+    REQUIRE(deserializeMsgPack(doc, input) == DeserializationError::Ok);
+
+    REQUIRE(measureDeserializeMsgPack(input) == doc.memoryUsage());
+  }
+
+  SECTION("applies the filter") {
+    DynamicJsonDocument filter(128);
+    filter["a"] = true;
+    std::string input("\x82\xA1\x61\xA1\x78\xA1\x62\xA1\x79");  // {"a":"x",...
+
+    size_t capacity =
+        measureDeserializeMsgPack(input, DeserializationOption::Filter(filter));
+
+    REQUIRE(capacity ==
+            JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(1) + JSON_STRING_SIZE(1));
+  }
+
+  SECTION("doesn't modify a char*") {
+    char input[] = "\x92\xA1\x61\xA1\x62";
+
+    size_t capacity = measureDeserializeMsgPack(input);
+
+    REQUIRE(capacity == JSON_ARRAY_SIZE(2));  // the strings stay in place
+    REQUIRE(std::string(input) == "\x92\xA1\x61\xA1\x62");
+  }
+
+  SECTION("returns 0 for invalid input") {
+    REQUIRE(measureDeserializeMsgPack("\x92\x01", 2) == 0);
+  }
+}
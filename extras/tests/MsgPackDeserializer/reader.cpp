@@ -0,0 +1,141 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+// Reads all the tokens and returns them as a string
+template <typename TReader>
+static std::string readAll(TReader& reader) {
+  std::ostringstream log;
+  while (reader.next()) {
+    switch (reader.type()) {
+      case JsonToken::ObjectStart:
+        log << "{";
+        break;
+      case JsonToken::ObjectEnd:
+        log << "}";
+        break;
+      case JsonToken::ArrayStart:
+        log << "[";
+        break;
+      case JsonToken::ArrayEnd:
+        log << "]";
+        break;
+      case JsonToken::Key:
+        log << reader.getString().c_str() << ":";
+        break;
+      case JsonToken::String:
+        log << "s(" << reader.getString().c_str() << ")";
+        break;
+      case JsonToken::Integer:
+        log << "i(" << reader.getInt64() << ")";
+        break;
+      case JsonToken::Float:
+        log << "f(" << reader.getFloat() << ")";
+        break;
+      case JsonToken::Boolean:
+        log << "b(" << reader.getBool() << ")";
+        break;
+      case JsonToken::Null:
+        log << "n";
+        break;
+      default:
+        log << "?";
+        break;
+    }
+  }
+  return log.str();
+}
+
+TEST_CASE("MsgPackReader") {
+  SECTION("all token types") {
+    std::string input(
+        "\x86\xA1s\xA5hello\xA1i\xD0\xD6\xA1\x66\xCA\x3F\xC0\x00\x00"
+        "\xA1\x62\xC3\xA1n\xC0\xA1\x61\x90",
+        30);
+    auto reader = makeMsgPackReader(input);
+    REQUIRE(readAll(reader) == "{s:s(hello)i:i(-42)f:f(1.5)b:b(1)n:na:[]}");
+    REQUIRE(reader.error() == DeserializationError::Ok);
+  }
+
+  SECTION("value at the root") {
+    auto reader = makeMsgPackReader("\x2A");
+    REQUIRE(readAll(reader) == "i(42)");
+    REQUIRE(reader.error() == DeserializationError::Ok);
+  }
+
+  SECTION("depth") {
+    auto reader = makeMsgPackReader("\x91\x81\xA1\x61\x91\x01");
+    REQUIRE(reader.next());  // [
+    REQUIRE(reader.depth() == 1);
+    REQUIRE(reader.next());  // {
+    REQUIRE(reader.depth() == 2);
+    REQUIRE(reader.next());  // "a"
+    REQUIRE(reader.next());  // [
+    REQUIRE(reader.depth() == 3);
+    REQUIRE(reader.next());  // 1
+    REQUIRE(reader.depth() == 3);
+    REQUIRE(reader.next());  // ]
+    REQUIRE(reader.depth() == 2);
+  }
+
+  SECTION("skipValue() after ArrayStart") {
+    auto reader =
+        makeMsgPackReader("\x82\xA1\x61\x92\x01\x92\x02\x03\xA1\x62\x04");
+    REQUIRE(reader.next());  // {
+    REQUIRE(reader.next());  // "a"
+    REQUIRE(reader.next());  // [
+    REQUIRE(reader.type() == JsonToken::ArrayStart);
+    REQUIRE(reader.skipValue());
+    REQUIRE(reader.depth() == 1);
+    REQUIRE(readAll(reader) == "b:i(4)}");
+  }
+
+  SECTION("skipValue() after Key") {
+    auto reader =
+        makeMsgPackReader("\x82\xA1\x61\x81\xA1x\x91\x01\xA1\x62\x04");
+    REQUIRE(reader.next());  // {
+    REQUIRE(reader.next());  // "a"
+    REQUIRE(reader.type() == JsonToken::Key);
+    REQUIRE(reader.skipValue());
+    REQUIRE(readAll(reader) == "b:i(4)}");
+  }
+
+  SECTION("std::istream") {
+    std::istringstream input("\x92\xA5hello\x80");
+    auto reader = makeMsgPackReader(input);
+    REQUIRE(readAll(reader) == "[s(hello){}]");
+  }
+
+  SECTION("incomplete input") {
+    auto reader = makeMsgPackReader("\x92\x01", 2);
+    REQUIRE(readAll(reader) == "[i(1)");
+    REQUIRE(reader.error() == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("empty input") {
+    auto reader = makeMsgPackReader("", 0);
+    REQUIRE(reader.next() == false);
+    REQUIRE(reader.error() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("nesting limit") {
+    auto reader =
+        makeMsgPackReader("\x91\x90", DeserializationOption::NestingLimit(1));
+    REQUIRE(readAll(reader) == "[");
+    REQUIRE(reader.error() == DeserializationError::TooDeep);
+  }
+
+  SECTION("nesting limit above the default") {
+    std::string input = std::string(14, '\x91') + "\x90";
+    auto reader =
+        makeMsgPackReader(input, DeserializationOption::NestingLimit(20));
+    REQUIRE(readAll(reader) == std::string(15, '[') + std::string(15, ']'));
+    REQUIRE(reader.error() == DeserializationError::Ok);
+  }
+}
@@ -0,0 +1,94 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+// Feeds the input in chunks of the specified size
+static DeserializationError feedInChunks(MsgPackStreamParser& parser,
+                                         const std::string& input,
+                                         size_t chunkSize) {
+  DeserializationError err = DeserializationError::NeedMoreData;
+  for (size_t i = 0; i < input.size(); i += chunkSize) {
+    std::string chunk = input.substr(i, chunkSize);
+    err = parser.feed(chunk.data(), chunk.size());
+    if (err != DeserializationError::NeedMoreData)
+      return err;
+  }
+  return parser.finish();
+}
+
+TEST_CASE("MsgPackStreamParser") {
+  DynamicJsonDocument doc(4096);
+  MsgPackStreamParser parser(doc);
+
+  SECTION("gives the same result as deserializeMsgPack() for all chunk sizes") {
+    std::string inputs[] = {
+        std::string("\x82\xA5hello\xA5world\xA6\x61nswer\x2A", 21),
+        std::string("\x93\x90\x80\xC0", 4),
+        std::string("\xDC\x00\x03\xCC\xFF\xCD\x01\x00\xD0\x80", 10),
+        std::string("\x94\xCE\x12\x34\x56\x78\xD2\xFF\xFF\xFF\xFF"
+                    "\xCA\x40\x48\xF5\xC3\xCB\x40\x09\x21\xFB\x54\x44\x2D\x18",
+                    25),
+        std::string("\xDE\x00\x01\xD9\x03key\xDA\x00\x05value", 16),
+        std::string("\x92\xC4\x02\x01\x02\xD6\x01\x01\x02\x03\x04", 11),
+        std::string("\x81\xA1\x61\x81\xA1\x62\x91\xC3", 8),
+    };
+
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+      const std::string& input = inputs[i];
+      DynamicJsonDocument expected(4096);
+      REQUIRE(deserializeMsgPack(expected, input) == DeserializationError::Ok);
+
+      for (size_t chunkSize = 1; chunkSize <= input.size(); chunkSize++) {
+        CAPTURE(i);
+        CAPTURE(chunkSize);
+        parser.reset();
+        REQUIRE(feedInChunks(parser, input, chunkSize) ==
+                DeserializationError::Ok);
+        REQUIRE(doc == expected);
+      }
+    }
+  }
+
+  SECTION("returns NeedMoreData until the document is complete") {
+    REQUIRE(parser.feed("\x92\x01", 2) == DeserializationError::NeedMoreData);
+    REQUIRE(parser.feed("\x02\x03", 2) == DeserializationError::Ok);
+    REQUIRE(parser.consumed() == 1);
+    REQUIRE(doc[1] == 2);
+  }
+
+  SECTION("finish() reports incomplete and empty input") {
+    REQUIRE(parser.feed("\x92\x01", 2) == DeserializationError::NeedMoreData);
+    REQUIRE(parser.finish() == DeserializationError::IncompleteInput);
+
+    parser.reset();
+    REQUIRE(parser.finish() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("invalid input") {
+    REQUIRE(parser.feed("\x81\x01\x02", 3) ==
+            DeserializationError::InvalidInput);
+  }
+
+  SECTION("nesting limit") {
+    MsgPackStreamParser limited(doc, DeserializationOption::NestingLimit(1));
+    REQUIRE(limited.feed("\x91\x90", 2) == DeserializationError::TooDeep);
+  }
+
+  SECTION("nesting limit above the default") {
+    std::string input = std::string(14, '\x91') + "\x90";
+    MsgPackStreamParser deep(doc, DeserializationOption::NestingLimit(20));
+    REQUIRE(deep.feed(input.data(), input.size()) == DeserializationError::Ok);
+  }
+
+  SECTION("not enough memory") {
+    DynamicJsonDocument small(JSON_ARRAY_SIZE(1));
+    MsgPackStreamParser smallParser(small);
+    REQUIRE(smallParser.feed("\x92\x01\x02", 3) ==
+            DeserializationError::NoMemory);
+  }
+}
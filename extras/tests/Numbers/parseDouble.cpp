@@ -16,6 +16,11 @@ void checkDouble(const char* input, double expected) {
   REQUIRE(parseNumber<double>(input) == Approx(expected));
 }
 
+void checkDoubleExact(const char* input, double expected) {
+  CAPTURE(input);
+  REQUIRE(parseNumber<double>(input) == expected);
+}
+
 void checkDoubleNaN(const char* input) {
   CAPTURE(input);
   double result = parseNumber<double>(input);
@@ -89,6 +94,31 @@ TEST_CASE("parseNumber<double>()") {
     checkDouble("1e-65535", 0.0);
   }
 
+  SECTION("CorrectlyRounded") {
+    checkDoubleExact("0.1", 0.1);
+    checkDoubleExact("0.3", 0.3);
+    checkDoubleExact("1e23", 1e23);
+    checkDoubleExact("8.98846567431158e307", 8.98846567431158e307);
+    checkDoubleExact("2.2250738585072011e-308", 2.2250738585072011e-308);
+    checkDoubleExact("4.9406564584124654e-324", 4.9406564584124654e-324);
+    checkDoubleExact("1.7976931348623157e308", 1.7976931348623157e308);
+    checkDoubleExact("9007199254740993.0", 9007199254740992.0);
+    checkDoubleExact("123456789012345678901234567890",
+                     123456789012345678901234567890.0);
+  }
+
+  SECTION("HalfwayWithManyDigits") {
+    // exactly halfway between 1 and the next double: rounds to even
+    checkDoubleExact("1.00000000000000011102230246251565404236316680908203125",
+                     1.0);
+    // slightly above halfway, only the last digit tells
+    checkDoubleExact(
+        "1.000000000000000111022302462515654042363166809082031250001",
+        1.0000000000000002);
+    checkDoubleExact("9007199254740993.0000000000000000000001",
+                     9007199254740994.0);
+  }
+
   SECTION("NaN") {
     checkDoubleNaN("NaN");
     checkDoubleNaN("nan");
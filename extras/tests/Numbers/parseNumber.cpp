@@ -5,6 +5,8 @@
 #include <ArduinoJson.hpp>
 #include <catch.hpp>
 
+#include <string.h>
+
 using namespace ArduinoJson;
 using namespace ArduinoJson::detail;
 
@@ -51,3 +53,52 @@ TEST_CASE("Invalid value") {
 
   REQUIRE(result.type() == uint8_t(VALUE_IS_NULL));
 }
+
+TEST_CASE("parseNumber() from a contiguous input") {
+  // These numbers have digits at all positions in the 8-digit blocks.
+  // We compare with the results of the null-terminated version, which reads
+  // one digit at a time.
+  const char* inputs[] = {
+      "1",
+      "12345678",
+      "123456789",
+      "1234567890123456",
+      "12345678901234567",
+      "18446744073709551615",
+      "18446744073709551616",
+      "-9223372036854775808",
+      "-9223372036854775809",
+      "123456789012345678901234567890",
+      "0.12345678",
+      "0.123456789",
+      "12345678.12345678",
+      "3.14159265358979323846264338327950288",
+      "1234567.1234567e-8",
+      "0.0000000000000000000000000000000000000000000000000000000001",
+  };
+
+  for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+    CAPTURE(inputs[i]);
+    VariantData expected, actual;
+    parseNumber(inputs[i], expected);
+
+    Latch<BoundedReader<const char*>> latch(
+        BoundedReader<const char*>(inputs[i], strlen(inputs[i])));
+    REQUIRE(parseNumber(latch, actual) == true);
+    REQUIRE(latch.current() == 0);
+
+    REQUIRE(actual.type() == expected.type());
+    REQUIRE(JsonVariantConst(&actual) == JsonVariantConst(&expected));
+  }
+}
+
+TEST_CASE("parseNumber() stops at the first invalid character") {
+  VariantData result;
+  Latch<BoundedReader<const char*>> latch(
+      BoundedReader<const char*>("123456789,", 10));
+
+  REQUIRE(parseNumber(latch, result) == true);
+  REQUIRE(latch.current() == ',');
+  REQUIRE(result.type() == uint8_t(VALUE_IS_UNSIGNED_INTEGER));
+  REQUIRE(JsonVariantConst(&result) == 123456789);
+}
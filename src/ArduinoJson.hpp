@@ -31,6 +31,7 @@
 #include "ArduinoJson/Variant/JsonVariantConst.hpp"
 
 #include "ArduinoJson/Document/DynamicJsonDocument.hpp"
+#include "ArduinoJson/Document/InSituJsonDocument.hpp"
 #include "ArduinoJson/Document/StaticJsonDocument.hpp"
 
 #include "ArduinoJson/Array/ElementProxy.hpp"
@@ -44,9 +45,16 @@
 #include "ArduinoJson/Variant/VariantImpl.hpp"
 
 #include "ArduinoJson/Json/JsonDeserializer.hpp"
+#include "ArduinoJson/Json/JsonExtractor.hpp"
+#include "ArduinoJson/Json/JsonLinesReader.hpp"
+#include "ArduinoJson/Json/JsonReader.hpp"
 #include "ArduinoJson/Json/JsonSerializer.hpp"
+#include "ArduinoJson/Json/JsonStreamParser.hpp"
+#include "ArduinoJson/Json/LazyJsonDocument.hpp"
 #include "ArduinoJson/Json/PrettyJsonSerializer.hpp"
 #include "ArduinoJson/MsgPack/MsgPackDeserializer.hpp"
+#include "ArduinoJson/MsgPack/MsgPackReader.hpp"
 #include "ArduinoJson/MsgPack/MsgPackSerializer.hpp"
+#include "ArduinoJson/MsgPack/MsgPackStreamParser.hpp"
 
 #include "ArduinoJson/compatibility.hpp"
@@ -108,12 +108,12 @@ class JsonArray : public detail::VariantOperators<JsonArray> {
   }
 
   // Removes all the elements of the array.
-  // ⚠️ Doesn't release the memory associated with the removed elements.
+  // ⚠️ Recycles the slots of the removed elements, but not their strings.
   // https://arduinojson.org/v6/api/jsonarray/clear/
   void clear() const {
     if (!data_)
       return;
-    data_->clear();
+    data_->removeAll(pool_);
   }
 
   // Gets or sets the element at the specified index.
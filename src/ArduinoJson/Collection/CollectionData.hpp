@@ -58,6 +58,7 @@ class CollectionData {
   // Generic
 
   void clear();
+  void removeAll(MemoryPool* pool);
   size_t memoryUsage() const;
   size_t size() const;
 
@@ -70,6 +71,14 @@ class CollectionData {
     return head_;
   }
 
+  VariantSlot* tail() const {
+    return tail_;
+  }
+
+  // Removes the slots that follow the specified one, in constant time.
+  // Pass null to remove all the slots.
+  void truncate(VariantSlot* last);
+
   void movePointers(ptrdiff_t stringDistance, ptrdiff_t variantDistance);
 
  private:
@@ -49,6 +49,37 @@ inline void CollectionData::clear() {
   tail_ = 0;
 }
 
+// Gives a chain of slots, and the slots of their children, back to the pool
+inline void releaseSlots(VariantSlot* slot, MemoryPool* pool) {
+  while (slot) {
+    VariantSlot* next = slot->next();
+    // a shallow copy shares the slots of another collection
+    const CollectionData* children = slot->data()->asOwnedCollection();
+    // insert the children in the chain, instead of recursing
+    if (children && children->head()) {
+      children->tail()->setNext(next);
+      next = children->head();
+    }
+    pool->freeVariant(slot);
+    slot = next;
+  }
+}
+
+inline void CollectionData::removeAll(MemoryPool* pool) {
+  // a shallow copy shares the slots of another collection
+  if (collectionToVariant(this)->asOwnedCollection())
+    releaseSlots(head_, pool);
+  clear();
+}
+
+inline void CollectionData::truncate(VariantSlot* last) {
+  if (last)
+    last->setNext(0);
+  else
+    head_ = 0;
+  tail_ = last;
+}
+
 template <typename TAdaptedString>
 inline bool CollectionData::containsKey(const TAdaptedString& key) const {
   return getSlot(key) != 0;
@@ -146,11 +146,30 @@
 #  define ARDUINOJSON_DECODE_UNICODE 1
 #endif
 
+// Replace malformed UTF-8 with \ufffd when serializing JSON
+#ifndef ARDUINOJSON_REPLACE_INVALID_UTF8
+#  define ARDUINOJSON_REPLACE_INVALID_UTF8 0
+#endif
+
 // Ignore comments in input
 #ifndef ARDUINOJSON_ENABLE_COMMENTS
 #  define ARDUINOJSON_ENABLE_COMMENTS 0
 #endif
 
+// Round parsed floating-point values to the nearest double (1), or use a
+// smaller but approximate algorithm (0).
+// The exact algorithm needs a 10KB table, so it's only enabled on 64-bit
+// targets.
+#ifndef ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+#  if ARDUINOJSON_USE_DOUBLE && \
+      (defined(__SIZEOF_POINTER__) && __SIZEOF_POINTER__ >= 8 || \
+       defined(_WIN64) && _WIN64)
+#    define ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING 1
+#  else
+#    define ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING 0
+#  endif
+#endif
+
 // Support NaN in JSON
 #ifndef ARDUINOJSON_ENABLE_NAN
 #  define ARDUINOJSON_ENABLE_NAN 0
@@ -199,10 +218,37 @@
 #  define ARDUINOJSON_ENABLE_STRING_DEDUPLICATION 1
 #endif
 
+// Number of entries in the hash table that speeds up the deduplication of
+// strings; each JsonDocument contains one. 0 disables it.
+// The deduplication finds 3/4 of this number of strings in constant time,
+// then it scans the memory pool for the others.
+#ifndef ARDUINOJSON_STRING_INDEX_SIZE
+#  define ARDUINOJSON_STRING_INDEX_SIZE 0
+#endif
+
+// Number of members and materialized values that each LazyJsonDocument
+// remembers, so it doesn't scan the input or parse the value again
+#ifndef ARDUINOJSON_LAZY_INDEX_SIZE
+#  define ARDUINOJSON_LAZY_INDEX_SIZE 8
+#endif
+
 #ifndef ARDUINOJSON_STRING_BUFFER_SIZE
 #  define ARDUINOJSON_STRING_BUFFER_SIZE 32
 #endif
 
+// Size of the buffer that holds the strings passed to a handler by
+// deserializeJson(handler, input), the strings returned by
+// JsonReader::getString(), and the keys of a LazyJsonDocument.
+// Longer strings fail with DeserializationError::StringTooLong, except when
+// the handler reads a writable input (char*), which holds its own strings.
+#ifndef ARDUINOJSON_HANDLER_BUFFER_SIZE
+#  if defined(__SIZEOF_POINTER__) && __SIZEOF_POINTER__ <= 2
+#    define ARDUINOJSON_HANDLER_BUFFER_SIZE 64
+#  else
+#    define ARDUINOJSON_HANDLER_BUFFER_SIZE 256
+#  endif
+#endif
+
 #ifndef ARDUINOJSON_DEBUG
 #  ifdef __PLATFORMIO_BUILD_DEBUG__
 #    define ARDUINOJSON_DEBUG 1
@@ -0,0 +1,29 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// Tells deserializeJson() that the objects don't contain duplicate keys, so
+// it can add each member without looking for a previous one.
+// This makes parsing objects linear instead of quadratic in the number of
+// members. If a key appears twice anyway, the object contains both members.
+class AssumeUniqueKeys {
+ public:
+  explicit AssumeUniqueKeys(bool enabled = true) : enabled_(enabled) {}
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+ private:
+  bool enabled_;
+};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
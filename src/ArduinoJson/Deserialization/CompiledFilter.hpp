@@ -0,0 +1,249 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/Filter.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+
+#include <string.h>  // strcmp
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A node of a CompiledFilter.
+// The children of a node are consecutive and sorted by key.
+struct CompiledFilterNode {
+  enum {
+    Allow = 1,
+    AllowArray = 2,
+    AllowObject = 4,
+    AllowValue = 8,
+    AllowAll = 16,  // "true" allows everything recursively
+    IsArray = 32,   // the child is the filter of all the elements
+  };
+
+  const char* key;
+  uint16_t firstChild;
+  uint16_t childCount;
+  uint16_t wildcard;  // the child whose key is "*", or 0
+  uint8_t flags;
+};
+
+// The filter that the deserializers use with a CompiledFilter.
+// Each lookup is a binary search in the keys of the current node.
+class CompiledFilterCursor {
+ public:
+  CompiledFilterCursor(const CompiledFilterNode* nodes, uint16_t index)
+      : nodes_(nodes), index_(index) {}
+
+  bool allow() const {
+    return has(CompiledFilterNode::Allow);
+  }
+
+  bool allowArray() const {
+    return has(CompiledFilterNode::AllowArray);
+  }
+
+  bool allowObject() const {
+    return has(CompiledFilterNode::AllowObject);
+  }
+
+  bool allowValue() const {
+    return has(CompiledFilterNode::AllowValue);
+  }
+
+  CompiledFilterCursor operator[](const char* key) const {
+    if (!nodes_ || has(CompiledFilterNode::AllowAll))
+      return *this;
+    const CompiledFilterNode& node = nodes_[index_];
+    if (node.flags & CompiledFilterNode::IsArray)
+      return deny();
+    size_t first = node.firstChild;
+    size_t last = first + node.childCount;
+    while (first < last) {
+      size_t middle = first + (last - first) / 2;
+      int cmp = strcmp(key, nodes_[middle].key);
+      if (cmp == 0)
+        return CompiledFilterCursor(nodes_, uint16_t(middle));
+      if (cmp < 0)
+        last = middle;
+      else
+        first = middle + 1;
+    }
+    return child(node.wildcard);
+  }
+
+  template <typename TIndex>
+  typename enable_if<is_integral<TIndex>::value, CompiledFilterCursor>::type
+  operator[](TIndex) const {
+    if (!nodes_ || has(CompiledFilterNode::AllowAll))
+      return *this;
+    const CompiledFilterNode& node = nodes_[index_];
+    if (node.flags & CompiledFilterNode::IsArray)
+      return child(node.childCount ? node.firstChild : 0);
+    return child(node.wildcard);
+  }
+
+  // Counts the paths that end with true.
+  // Returns false if a path contains a wildcard or an array.
+  bool countPaths(size_t& count) const {
+    if (!nodes_)
+      return true;
+    const CompiledFilterNode& node = nodes_[index_];
+    if (node.flags & CompiledFilterNode::AllowAll) {
+      count++;
+      return true;
+    }
+    if (node.wildcard || (node.flags & CompiledFilterNode::IsArray))
+      return false;
+    for (uint16_t i = 0; i < node.childCount; i++) {
+      CompiledFilterCursor child(nodes_, uint16_t(node.firstChild + i));
+      if (!child.countPaths(count))
+        return false;
+    }
+    return true;
+  }
+
+ private:
+  bool has(uint8_t flag) const {
+    return nodes_ && (nodes_[index_].flags & flag);
+  }
+
+  CompiledFilterCursor child(uint16_t index) const {
+    return index ? CompiledFilterCursor(nodes_, index) : deny();
+  }
+
+  static CompiledFilterCursor deny() {
+    return CompiledFilterCursor(0, 0);
+  }
+
+  const CompiledFilterNode* nodes_;  // null means "deny all"
+  uint16_t index_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// A filter that is compiled once into a table of sorted keys, so it can be
+// reused for many calls to deserializeJson() or deserializeMsgPack().
+// The capacity is the number of values in the filter document.
+// The keys are not copied, so the filter document must outlive this object.
+template <size_t capacity>
+class CompiledFilter {
+  static_assert(capacity > 0 && capacity < 65535,
+                "CompiledFilter's capacity is out of range");
+
+ public:
+  explicit CompiledFilter(JsonVariantConst filter)
+      : size_(1), overflowed_(false) {
+    compile(filter, 0);
+    if (overflowed_) {
+      // a partial filter would silently drop values, so drop everything
+      size_ = 1;
+      nodes_[0] = detail::CompiledFilterNode();
+    }
+  }
+
+  // Returns true if the filter document has more values than the capacity.
+  // In that case, the compiled filter rejects everything.
+  bool overflowed() const {
+    return overflowed_;
+  }
+
+  detail::CompiledFilterCursor root() const {
+    return detail::CompiledFilterCursor(nodes_, 0);
+  }
+
+ private:
+  void compile(JsonVariantConst filter, uint16_t index) {
+    Filter reference(filter);
+    uint8_t flags = 0;
+    if (reference.allow())
+      flags |= detail::CompiledFilterNode::Allow;
+    if (reference.allowArray())
+      flags |= detail::CompiledFilterNode::AllowArray;
+    if (reference.allowObject())
+      flags |= detail::CompiledFilterNode::AllowObject;
+    if (reference.allowValue())
+      flags |= detail::CompiledFilterNode::AllowValue;
+    if (filter == true)
+      flags |= detail::CompiledFilterNode::AllowAll;
+
+    uint16_t first = size_;
+    uint16_t count = 0;
+
+    // reserve a block for the children, so they are consecutive
+    if (filter.is<JsonObjectConst>()) {
+      for (JsonPairConst kv : filter.as<JsonObjectConst>()) {
+        if (!kv.value().isNull())  // null members are like missing ones
+          count++;
+      }
+    } else if (filter.is<JsonArrayConst>()) {
+      flags |= detail::CompiledFilterNode::IsArray;
+      if (!filter[0].isNull())
+        count = 1;
+    }
+    if (!reserve(count))
+      return;
+
+    nodes_[index].key = 0;
+    nodes_[index].firstChild = count ? first : 0;
+    nodes_[index].childCount = count;
+    nodes_[index].wildcard = 0;
+    nodes_[index].flags = flags;
+
+    if (filter.is<JsonObjectConst>()) {
+      uint16_t child = first;
+      for (JsonPairConst kv : filter.as<JsonObjectConst>()) {
+        if (kv.value().isNull())
+          continue;
+        compile(kv.value(), child);
+        nodes_[child].key = kv.key().c_str();
+        child++;
+      }
+      if (overflowed_)
+        return;
+      sortChildren(first, count);
+      for (uint16_t i = first; i < first + count; i++) {
+        if (!strcmp(nodes_[i].key, "*"))
+          nodes_[index].wildcard = i;
+      }
+    } else if (count) {
+      compile(filter[0], first);
+    }
+  }
+
+  bool reserve(uint16_t count) {
+    if (count > capacity - size_) {
+      overflowed_ = true;
+      return false;
+    }
+    size_ = uint16_t(size_ + count);
+    return true;
+  }
+
+  // Insertion sort; the subtrees don't move since they are outside the block
+  void sortChildren(uint16_t first, uint16_t count) {
+    if (capacity < 2)  // nothing to sort, and silences -Warray-bounds
+      return;
+    for (uint16_t i = uint16_t(first + 1); i < first + count; i++) {
+      detail::CompiledFilterNode node = nodes_[i];
+      uint16_t j = i;
+      while (j > first && strcmp(nodes_[j - 1].key, node.key) > 0) {
+        nodes_[j] = nodes_[j - 1];
+        j--;
+      }
+      nodes_[j] = node;
+    }
+  }
+
+  detail::CompiledFilterNode nodes_[capacity];
+  uint16_t size_;
+  bool overflowed_;
+};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -22,7 +22,10 @@ class DeserializationError {
     IncompleteInput,
     InvalidInput,
     NoMemory,
-    TooDeep
+    TooDeep,
+    NeedMoreData,
+    InvalidUtf8,
+    StringTooLong
   };
 
   DeserializationError() {}
@@ -64,8 +67,9 @@ class DeserializationError {
 
   const char* c_str() const {
     static const char* messages[] = {
-        "Ok",           "EmptyInput", "IncompleteInput",
-        "InvalidInput", "NoMemory",   "TooDeep"};
+        "Ok",           "EmptyInput",  "IncompleteInput", "InvalidInput",
+        "NoMemory",     "TooDeep",     "NeedMoreData",    "InvalidUtf8",
+        "StringTooLong"};
     ARDUINOJSON_ASSERT(static_cast<size_t>(code_) <
                        sizeof(messages) / sizeof(messages[0]));
     return messages[code_];
@@ -79,8 +83,11 @@ class DeserializationError {
     ARDUINOJSON_DEFINE_PROGMEM_ARRAY(char, s3, "InvalidInput");
     ARDUINOJSON_DEFINE_PROGMEM_ARRAY(char, s4, "NoMemory");
     ARDUINOJSON_DEFINE_PROGMEM_ARRAY(char, s5, "TooDeep");
+    ARDUINOJSON_DEFINE_PROGMEM_ARRAY(char, s6, "NeedMoreData");
+    ARDUINOJSON_DEFINE_PROGMEM_ARRAY(char, s7, "InvalidUtf8");
+    ARDUINOJSON_DEFINE_PROGMEM_ARRAY(char, s8, "StringTooLong");
     ARDUINOJSON_DEFINE_PROGMEM_ARRAY(const char*, messages,
-                                     {s0, s1, s2, s3, s4, s5});
+                                     {s0, s1, s2, s3, s4, s5, s6, s7, s8});
     return reinterpret_cast<const __FlashStringHelper*>(
         detail::pgm_read(messages + code_));
   }
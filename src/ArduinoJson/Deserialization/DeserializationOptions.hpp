@@ -4,8 +4,15 @@
 
 #pragma once
 
+#include <ArduinoJson/Deserialization/AssumeUniqueKeys.hpp>
+#include <ArduinoJson/Deserialization/CompiledFilter.hpp>
+#include <ArduinoJson/Deserialization/ElementFilter.hpp>
 #include <ArduinoJson/Deserialization/Filter.hpp>
+#include <ArduinoJson/Deserialization/LazyNumbers.hpp>
 #include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Deserialization/StopWhenFilled.hpp>
+#include <ArduinoJson/Deserialization/ValidateUtf8.hpp>
+#include <ArduinoJson/Deserialization/ZeroCopy.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
@@ -13,23 +20,167 @@ template <typename TFilter>
 struct DeserializationOptions {
   TFilter filter;
   DeserializationOption::NestingLimit nestingLimit;
+  bool assumeUniqueKeys;
+  bool zeroCopy;
+  bool validateUtf8;
+  bool lazyNumbers;
+  bool stopWhenFilled;
 };
 
+// Tells whether an argument is an option; otherwise, it's a filter
+template <typename T>
+struct IsDeserializationOption : false_type {};
+
+template <>
+struct IsDeserializationOption<DeserializationOption::NestingLimit>
+    : true_type {};
+
+template <>
+struct IsDeserializationOption<DeserializationOption::AssumeUniqueKeys>
+    : true_type {};
+
+template <>
+struct IsDeserializationOption<DeserializationOption::ZeroCopy> : true_type {};
+
+template <>
+struct IsDeserializationOption<DeserializationOption::ValidateUtf8>
+    : true_type {};
+
+template <>
+struct IsDeserializationOption<DeserializationOption::LazyNumbers>
+    : true_type {};
+
+template <>
+struct IsDeserializationOption<DeserializationOption::StopWhenFilled>
+    : true_type {};
+
+// The type of filter that the deserializer receives
 template <typename TFilter>
-inline DeserializationOptions<TFilter> makeDeserializationOptions(
-    TFilter filter, DeserializationOption::NestingLimit nestingLimit = {}) {
-  return {filter, nestingLimit};
+struct FilterCursor {
+  typedef TFilter type;
+};
+
+// A CompiledFilter is passed by reference; the deserializer only gets a cursor
+template <size_t capacity>
+struct FilterCursor<DeserializationOption::CompiledFilter<capacity>> {
+  typedef CompiledFilterCursor type;
+};
+
+template <>
+struct FilterCursor<DeserializationOption::ElementFilter> {
+  typedef ElementFilterCursor type;
+};
+
+// Finds the filter in the arguments; AllowAllFilter if there is none
+template <typename... Args>
+struct FilterOf {
+  typedef AllowAllFilter type;
+};
+
+template <typename T, typename... Rest>
+struct FilterOf<T, Rest...> {
+  typedef typename conditional<IsDeserializationOption<T>::value,
+                               typename FilterOf<Rest...>::type,
+                               typename FilterCursor<T>::type>::type type;
+};
+
+inline AllowAllFilter getFilter() {
+  return AllowAllFilter();
+}
+
+template <typename TFilter, typename... Rest>
+typename enable_if<!IsDeserializationOption<TFilter>::value, TFilter>::type
+getFilter(const TFilter& filter, const Rest&...) {
+  return filter;
+}
+
+template <size_t capacity, typename... Rest>
+CompiledFilterCursor getFilter(
+    const DeserializationOption::CompiledFilter<capacity>& filter,
+    const Rest&...) {
+  return filter.root();
+}
+
+template <typename... Rest>
+ElementFilterCursor getFilter(
+    const DeserializationOption::ElementFilter& filter, const Rest&...) {
+  return filter.root();
+}
+
+template <typename T, typename... Rest>
+typename enable_if<IsDeserializationOption<T>::value,
+                   typename FilterOf<Rest...>::type>::type
+getFilter(const T&, const Rest&... rest) {
+  return getFilter(rest...);
 }
 
 template <typename TFilter>
-inline DeserializationOptions<TFilter> makeDeserializationOptions(
-    DeserializationOption::NestingLimit nestingLimit, TFilter filter) {
-  return {filter, nestingLimit};
+inline void applyOptions(DeserializationOptions<TFilter>&) {}
+
+template <typename TFilter, typename T, typename... Rest>
+inline void applyOptions(DeserializationOptions<TFilter>& options, const T&,
+                         const Rest&... rest) {
+  // the filter has already been set by getFilter()
+  applyOptions(options, rest...);
+}
+
+template <typename TFilter, typename... Rest>
+inline void applyOptions(DeserializationOptions<TFilter>& options,
+                         DeserializationOption::NestingLimit nestingLimit,
+                         const Rest&... rest) {
+  options.nestingLimit = nestingLimit;
+  applyOptions(options, rest...);
+}
+
+template <typename TFilter, typename... Rest>
+inline void applyOptions(DeserializationOptions<TFilter>& options,
+                         DeserializationOption::AssumeUniqueKeys unique,
+                         const Rest&... rest) {
+  options.assumeUniqueKeys = unique.enabled();
+  applyOptions(options, rest...);
+}
+
+template <typename TFilter, typename... Rest>
+inline void applyOptions(DeserializationOptions<TFilter>& options,
+                         DeserializationOption::ZeroCopy zeroCopy,
+                         const Rest&... rest) {
+  options.zeroCopy = zeroCopy.enabled();
+  applyOptions(options, rest...);
+}
+
+template <typename TFilter, typename... Rest>
+inline void applyOptions(DeserializationOptions<TFilter>& options,
+                         DeserializationOption::ValidateUtf8 validate,
+                         const Rest&... rest) {
+  options.validateUtf8 = validate.enabled();
+  applyOptions(options, rest...);
+}
+
+template <typename TFilter, typename... Rest>
+inline void applyOptions(DeserializationOptions<TFilter>& options,
+                         DeserializationOption::LazyNumbers lazyNumbers,
+                         const Rest&... rest) {
+  options.lazyNumbers = lazyNumbers.enabled();
+  applyOptions(options, rest...);
+}
+
+template <typename TFilter, typename... Rest>
+inline void applyOptions(DeserializationOptions<TFilter>& options,
+                         DeserializationOption::StopWhenFilled stop,
+                         const Rest&... rest) {
+  options.stopWhenFilled = stop.enabled();
+  applyOptions(options, rest...);
 }
 
-inline DeserializationOptions<AllowAllFilter> makeDeserializationOptions(
-    DeserializationOption::NestingLimit nestingLimit = {}) {
-  return {{}, nestingLimit};
+// Gathers the filter and the options, which can be passed in any order
+template <typename... Args>
+inline DeserializationOptions<typename FilterOf<Args...>::type>
+makeDeserializationOptions(const Args&... args) {
+  DeserializationOptions<typename FilterOf<Args...>::type> options = {
+      getFilter(args...), DeserializationOption::NestingLimit(), false, false,
+      false, false, false};
+  applyOptions(options, args...);
+  return options;
 }
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,169 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/Filter.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+class ElementFilter;
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The filter that the deserializer uses with an ElementFilter.
+// It behaves like Filter, except for the elements of the selected array.
+class ElementFilterCursor {
+ public:
+  ElementFilterCursor(const DeserializationOption::ElementFilter* owner,
+                      JsonVariantConst variant)
+      : owner_(owner), variant_(variant) {}
+
+  bool allow() const {
+    return filter().allow();
+  }
+
+  bool allowArray() const {
+    return filter().allowArray();
+  }
+
+  bool allowObject() const {
+    return filter().allowObject();
+  }
+
+  bool allowValue() const {
+    return filter().allowValue();
+  }
+
+  template <typename TKey>
+  ElementFilterCursor operator[](const TKey& key) const {
+    if (variant_ == true)  // "true" means "allow recursively"
+      return *this;
+    JsonVariantConst member = variant_[key];
+    return ElementFilterCursor(owner_,
+                               member.isNull() ? variant_["*"] : member);
+  }
+
+  // Returns the filter of the element at the specified index.
+  // Denies the elements of the selected array that are outside the slice.
+  ElementFilterCursor element(size_t index) const;
+
+  // Returns true if the elements must pass the predicate once parsed
+  bool hasPredicate() const;
+
+  // Returns true if the predicate accepts the element
+  bool keep(const VariantData* element) const;
+
+  bool countPaths(size_t& count) const {
+    return filter().countPaths(count);
+  }
+
+ private:
+  DeserializationOption::Filter filter() const {
+    return DeserializationOption::Filter(variant_);
+  }
+
+  bool isSelectedArray() const;
+
+  const DeserializationOption::ElementFilter* owner_;
+  JsonVariantConst variant_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// A Filter that also selects the elements of one of the arrays, by index
+// and by value.
+// The elements outside the slice are skipped; the others are parsed, and
+// the ones that the predicate rejects are removed right away, so their
+// memory is reused by the next element.
+// Only deserializeJson() supports the slice and the predicate;
+// deserializeMsgPack() uses this as a regular Filter.
+class ElementFilter {
+  friend class detail::ElementFilterCursor;
+
+ public:
+  typedef bool (*Predicate)(JsonVariantConst element);
+
+  // The array is the member of the filter that describes the selected array,
+  // like filter["events"] in {"events":[{"type":true}]}. It must be an array.
+  ElementFilter(JsonVariantConst filter, JsonVariantConst array)
+      : filter_(filter),
+        array_(detail::VariantAttorney::getData(array)),
+        begin_(0),
+        end_(size_t(-1)),
+        step_(1),
+        predicate_(0) {}
+
+  // Selects the root array.
+  explicit ElementFilter(JsonVariantConst filter)
+      : filter_(filter),
+        array_(detail::VariantAttorney::getData(filter)),
+        begin_(0),
+        end_(size_t(-1)),
+        step_(1),
+        predicate_(0) {}
+
+  // Keeps the elements from begin (included) to end (excluded), taking one
+  // element every step.
+  ElementFilter& slice(size_t begin, size_t end = size_t(-1),
+                       size_t step = 1) {
+    begin_ = begin;
+    end_ = end;
+    step_ = step ? step : 1;
+    return *this;
+  }
+
+  // Keeps the elements for which the predicate returns true.
+  // The element only contains the members that the filter allows.
+  ElementFilter& where(Predicate predicate) {
+    predicate_ = predicate;
+    return *this;
+  }
+
+  detail::ElementFilterCursor root() const {
+    return detail::ElementFilterCursor(this, filter_);
+  }
+
+ private:
+  bool inSlice(size_t index) const {
+    return index >= begin_ && index < end_ && (index - begin_) % step_ == 0;
+  }
+
+  JsonVariantConst filter_;
+  const detail::VariantData* array_;
+  size_t begin_, end_, step_;
+  Predicate predicate_;
+};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+inline bool ElementFilterCursor::isSelectedArray() const {
+  return owner_->array_ && VariantAttorney::getData(variant_) == owner_->array_;
+}
+
+inline ElementFilterCursor ElementFilterCursor::element(size_t index) const {
+  if (isSelectedArray() && !owner_->inSlice(index))
+    return ElementFilterCursor(owner_, JsonVariantConst());
+  return operator[](0UL);
+}
+
+inline bool ElementFilterCursor::hasPredicate() const {
+  return owner_->predicate_ && isSelectedArray();
+}
+
+inline bool ElementFilterCursor::keep(const VariantData* element) const {
+  return owner_->predicate_(JsonVariantConst(element));
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
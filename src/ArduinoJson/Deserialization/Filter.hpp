@@ -6,6 +6,30 @@
 
 #include <ArduinoJson/Namespace.hpp>
 
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Counts the paths of a filter that end with true.
+// Returns false if a path contains a wildcard or an array, since they match
+// an unknown number of values.
+template <typename TVariant>
+bool countFilterPaths(TVariant filter, size_t& count) {
+  if (filter == true) {
+    count++;
+    return true;
+  }
+  if (filter.template is<JsonArrayConst>())
+    return false;
+  if (!filter.template is<JsonObjectConst>())
+    return true;
+  for (JsonPairConst kv : filter.template as<JsonObjectConst>()) {
+    if (kv.key() == "*" || !countFilterPaths(kv.value(), count))
+      return false;
+  }
+  return true;
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
 ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
 
 namespace DeserializationOption {
@@ -37,6 +61,10 @@ class Filter {
     return Filter(member.isNull() ? variant_["*"] : member);
   }
 
+  bool countPaths(size_t& count) const {
+    return detail::countFilterPaths(variant_, count);
+  }
+
  private:
   JsonVariantConst variant_;
 };
@@ -64,6 +92,37 @@ struct AllowAllFilter {
   AllowAllFilter operator[](const TKey&) const {
     return AllowAllFilter();
   }
+
+  bool countPaths(size_t&) const {
+    return false;
+  }
+};
+
+struct DenyAllFilter {
+  bool allow() const {
+    return false;
+  }
+
+  bool allowArray() const {
+    return false;
+  }
+
+  bool allowObject() const {
+    return false;
+  }
+
+  bool allowValue() const {
+    return false;
+  }
+
+  template <typename TKey>
+  DenyAllFilter operator[](const TKey&) const {
+    return DenyAllFilter();
+  }
+
+  bool countPaths(size_t&) const {
+    return true;
+  }
 };
 }  // namespace detail
 
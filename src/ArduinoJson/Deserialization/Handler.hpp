@@ -0,0 +1,74 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Strings/JsonString.hpp>
+#include <ArduinoJson/Variant/Visitor.hpp>
+
+// deserializeJson(handler, input) and deserializeMsgPack(handler, input) don't
+// build a document; instead, they call the following member functions of the
+// handler:
+//
+//   bool onObjectStart();       // return false to skip the object
+//   void onObjectEnd();
+//   bool onKey(JsonString);     // return false to skip the member's value
+//   bool onArrayStart();        // return false to skip the array
+//   void onArrayEnd();
+//   void onString(JsonString);
+//   void onInteger(JsonInteger);
+//   void onInteger(JsonUInt);
+//   void onFloat(JsonFloat);
+//   void onBool(bool);
+//   void onNull();
+//
+// The JsonString passed to onKey() and onString() is only valid during the
+// call.
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Tells whether T has the member functions of a handler; checking a few of
+// them is enough to tell a handler from a JsonDocument or a JsonVariant
+template <typename T, typename Enable = void>
+struct IsHandler : false_type {};
+
+template <typename T>
+struct IsHandler<
+    T, typename make_void<decltype(
+           declval<T&>().onObjectStart(), declval<T&>().onArrayStart(),
+           declval<T&>().onString(declval<JsonString>()),
+           declval<T&>().onNull())>::type> : true_type {};
+
+// Forwards a scalar value to the handler
+template <typename THandler>
+class HandlerEmitter : public Visitor<void> {
+ public:
+  HandlerEmitter(THandler& handler) : handler_(handler) {}
+
+  void visitBoolean(bool value) {
+    handler_.onBool(value);
+  }
+
+  void visitFloat(JsonFloat value) {
+    handler_.onFloat(value);
+  }
+
+  void visitSignedInteger(JsonInteger value) {
+    handler_.onInteger(value);
+  }
+
+  void visitUnsignedInteger(JsonUInt value) {
+    handler_.onInteger(value);
+  }
+
+  void visitNull() {
+    handler_.onNull();
+  }
+
+ private:
+  THandler& handler_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
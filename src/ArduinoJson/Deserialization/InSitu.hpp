@@ -0,0 +1,58 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/StringStorage/StringMover.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A reference to a mutable contiguous container (std::string,
+// std::vector<char>...) that the deserializers parse in place.
+// Created by inSitu().
+template <typename TContainer>
+class InSitu {
+ public:
+  explicit InSitu(TContainer& container) : container_(&container) {}
+
+  char* data() const {
+    return container_->size() ? &(*container_)[0] : 0;
+  }
+
+  size_t size() const {
+    return container_->size();
+  }
+
+ private:
+  TContainer* container_;
+};
+
+// Tells deserializeJson() and deserializeMsgPack() to parse the container in
+// place, like they do with a char*.
+// The content of the container is destroyed, and the strings in the
+// JsonDocument point to the container, so it must outlive the document.
+// See InSituJsonDocument to tie the container to the document.
+template <typename TContainer>
+InSitu<TContainer> inSitu(TContainer& container) {
+  return InSitu<TContainer>(container);
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+template <typename TContainer>
+struct Reader<InSitu<TContainer>, void> : IteratorReader<const char*> {
+  explicit Reader(const InSitu<TContainer>& input)
+      : IteratorReader<const char*>(input.data(),
+                                    input.data() + input.size()) {}
+};
+
+template <typename TContainer>
+StringMover makeStringStorage(InSitu<TContainer> input, MemoryPool*) {
+  return StringMover(input.data());
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
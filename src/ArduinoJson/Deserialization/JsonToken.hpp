@@ -0,0 +1,28 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// The tokens returned by JsonReader and MsgPackReader
+struct JsonToken {
+  enum Type {
+    None,
+    ObjectStart,
+    ObjectEnd,
+    ArrayStart,
+    ArrayEnd,
+    Key,
+    String,
+    Integer,
+    Float,
+    Boolean,
+    Null
+  };
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
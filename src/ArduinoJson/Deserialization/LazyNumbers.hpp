@@ -0,0 +1,32 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// Tells deserializeJson() to store the numbers as text, and to convert them
+// only when you call as<T>() or is<T>().
+// serializeJson() writes the text unchanged, so forwarding a big integer or
+// a long decimal loses no precision.
+// Each number takes the size of its text in the pool.
+// The numbers that aren't strict JSON, like NaN or 1., are converted as
+// usual. So are the numbers of an in-place parse, which can't store the text.
+class LazyNumbers {
+ public:
+  explicit LazyNumbers(bool enabled = true) : enabled_(enabled) {}
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+ private:
+  bool enabled_;
+};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -13,11 +13,11 @@ namespace DeserializationOption {
 class NestingLimit {
  public:
   NestingLimit() : value_(ARDUINOJSON_DEFAULT_NESTING_LIMIT) {}
-  explicit NestingLimit(uint8_t n) : value_(n) {}
+  explicit NestingLimit(uint16_t n) : value_(n) {}
 
   NestingLimit decrement() const {
     ARDUINOJSON_ASSERT(value_ > 0);
-    return NestingLimit(static_cast<uint8_t>(value_ - 1));
+    return NestingLimit(static_cast<uint16_t>(value_ - 1));
   }
 
   bool reached() const {
@@ -25,7 +25,7 @@ class NestingLimit {
   }
 
  private:
-  uint8_t value_;
+  uint16_t value_;
 };
 }  // namespace DeserializationOption
 
@@ -0,0 +1,124 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/DefaultAllocator.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+
+#include <stddef.h>  // size_t
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The stack of the collections that are being parsed.
+// The first levels live in the object itself; deeper levels move to a buffer
+// from the allocator, which grows with the depth of the document.
+// The parsers check the NestingLimit before calling push(), so the stack
+// never holds more frames than the caller allows.
+// T must be trivially copyable.
+template <typename T, size_t inlineCapacity = ARDUINOJSON_DEFAULT_NESTING_LIMIT,
+          typename TAllocator = DefaultAllocator>
+class ParseStack {
+ public:
+  ParseStack()
+      : frames_(inlineFrames()), size_(0), capacity_(inlineCapacity) {}
+
+  ParseStack(ParseStack&& src)
+      : allocator_(src.allocator_),
+        frames_(inlineFrames()),
+        size_(src.size_),
+        capacity_(src.capacity_) {
+    if (src.isAllocated()) {
+      frames_ = src.frames_;
+      src.frames_ = src.inlineFrames();
+      src.capacity_ = inlineCapacity;
+    } else {
+      memcpy(frames_, src.frames_, size_ * sizeof(T));
+    }
+    src.size_ = 0;
+  }
+
+  ~ParseStack() {
+    if (isAllocated())
+      allocator_.deallocate(frames_);
+  }
+
+  // Returns false if the allocator fails
+  bool push(const T& frame) {
+    if (size_ == capacity_ && !grow())
+      return false;
+    frames_[size_++] = frame;
+    return true;
+  }
+
+  void pop() {
+    ARDUINOJSON_ASSERT(size_ > 0);
+    size_--;
+  }
+
+  T& top() {
+    ARDUINOJSON_ASSERT(size_ > 0);
+    return frames_[size_ - 1];
+  }
+
+  const T& top() const {
+    ARDUINOJSON_ASSERT(size_ > 0);
+    return frames_[size_ - 1];
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  // Keeps the buffer, so the next document doesn't allocate again
+  void clear() {
+    size_ = 0;
+  }
+
+ private:
+  ParseStack(const ParseStack&);
+  ParseStack& operator=(const ParseStack&);
+
+  T* inlineFrames() {
+    return reinterpret_cast<T*>(inline_.bytes);
+  }
+
+  bool isAllocated() const {
+    return frames_ != reinterpret_cast<const T*>(inline_.bytes);
+  }
+
+  bool grow() {
+    size_t capacity = capacity_ * 2;
+    T* frames;
+    if (isAllocated()) {
+      frames =
+          static_cast<T*>(allocator_.reallocate(frames_, capacity * sizeof(T)));
+    } else {
+      frames = static_cast<T*>(allocator_.allocate(capacity * sizeof(T)));
+      if (frames)
+        memcpy(frames, frames_, size_ * sizeof(T));
+    }
+    if (!frames)
+      return false;
+    frames_ = frames;
+    capacity_ = capacity;
+    return true;
+  }
+
+  TAllocator allocator_;
+  T* frames_;
+  size_t size_, capacity_;
+  // raw bytes, so T doesn't need a default constructor
+  union {
+    char bytes[inlineCapacity * sizeof(T)];
+    void* align;
+  } inline_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -5,6 +5,8 @@
 #pragma once
 
 #include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Polyfills/type_traits/declval.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
 
 #include <stdlib.h>  // for size_t
@@ -61,6 +63,19 @@ ARDUINOJSON_END_PRIVATE_NAMESPACE
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
+// A reader is "contiguous" when its input is a buffer in RAM that can be
+// scanned with a pointer, instead of calling read() for each byte.
+template <typename TReader, typename Enable = void>
+struct IsContiguousReader : false_type {};
+
+template <typename TReader>
+struct IsContiguousReader<
+    TReader, typename enable_if<
+                 is_same<decltype(declval<const TReader>().begin()),
+                         const char*>::value &&
+                 is_same<decltype(declval<const TReader>().end()),
+                         const char*>::value>::type> : true_type {};
+
 template <typename TInput>
 Reader<typename remove_reference<TInput>::type> makeReader(TInput&& input) {
   return Reader<typename remove_reference<TInput>::type>{
@@ -27,6 +27,15 @@ class IteratorReader {
       buffer[i++] = *ptr_++;
     return i;
   }
+
+  // Returns the bytes that haven't been read yet
+  TIterator begin() const {
+    return ptr_;
+  }
+
+  TIterator end() const {
+    return end_;
+  }
 };
 
 template <typename T>
@@ -34,12 +43,37 @@ struct void_ {
   typedef void type;
 };
 
+// Tells whether the source stores its characters in a contiguous array, like
+// std::string, std::string_view, or std::vector<char>
+template <typename TSource, typename Enable = void>
+struct IsContiguousContainer : false_type {};
+
 template <typename TSource>
-struct Reader<TSource, typename void_<typename TSource::const_iterator>::type>
-    : IteratorReader<typename TSource::const_iterator> {
+struct IsContiguousContainer<
+    TSource,
+    typename enable_if<is_same<decltype(declval<const TSource>().data()),
+                               const char*>::value>::type> : true_type {};
+
+template <typename TSource>
+struct Reader<
+    TSource,
+    typename enable_if<!IsContiguousContainer<TSource>::value,
+                       typename void_<typename TSource::const_iterator>::type>::
+        type> : IteratorReader<typename TSource::const_iterator> {
   explicit Reader(const TSource& source)
       : IteratorReader<typename TSource::const_iterator>(source.begin(),
                                                          source.end()) {}
 };
 
+// Contiguous containers are read with a pointer, so the deserializer can scan
+// them directly
+template <typename TSource>
+struct Reader<TSource,
+              typename enable_if<IsContiguousContainer<TSource>::value>::type>
+    : IteratorReader<const char*> {
+  explicit Reader(const TSource& source)
+      : IteratorReader<const char*>(source.data(),
+                                    source.data() + source.size()) {}
+};
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
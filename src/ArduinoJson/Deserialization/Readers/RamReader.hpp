@@ -6,6 +6,8 @@
 
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 
+#include <string.h>  // strlen
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 template <typename T>
@@ -36,6 +38,15 @@ struct Reader<TSource*,
       buffer[i] = *ptr_++;
     return length;
   }
+
+  // Returns the bytes that haven't been read yet (up to the terminator)
+  const char* begin() const {
+    return ptr_;
+  }
+
+  const char* end() const {
+    return ptr_ + strlen(ptr_);
+  }
 };
 
 template <typename TSource>
@@ -8,23 +8,46 @@
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
+// Reads directly from the stream buffer: this skips the sentry object and the
+// virtual call that std::istream::get() does for each byte.
+// The stream buffer reads from the source by blocks, and we only consume what
+// the parser needs, so the remaining bytes stay in the stream.
 template <typename TSource>
 struct Reader<TSource, typename enable_if<
                            is_base_of<std::istream, TSource>::value>::type> {
  public:
-  explicit Reader(std::istream& stream) : stream_(&stream) {}
+  explicit Reader(std::istream& stream)
+      : stream_(&stream), buffer_(stream.good() ? stream.rdbuf() : 0) {}
 
   int read() {
-    return stream_->get();
+    if (buffer_) {
+      int c = buffer_->sbumpc();
+      if (c != std::char_traits<char>::eof())
+        return c;
+    }
+    setEof();
+    return -1;
   }
 
   size_t readBytes(char* buffer, size_t length) {
-    stream_->read(buffer, static_cast<std::streamsize>(length));
-    return static_cast<size_t>(stream_->gcount());
+    size_t n = 0;
+    if (buffer_)
+      n = static_cast<size_t>(
+          buffer_->sgetn(buffer, static_cast<std::streamsize>(length)));
+    if (n < length)
+      setEof();
+    return n;
   }
 
  private:
+  void setEof() {
+    // same as std::istream::get() and std::istream::read()
+    buffer_ = 0;
+    stream_->setstate(std::ios::eofbit | std::ios::failbit);
+  }
+
   std::istream* stream_;
+  std::streambuf* buffer_;
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -11,9 +11,13 @@ ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 template <typename TVariant>
 struct Reader<TVariant, typename enable_if<IsVariant<TVariant>::value>::type>
-    : Reader<char*, void> {
-  explicit Reader(const TVariant& x)
-      : Reader<char*, void>(x.template as<const char*>()) {}
+    : BoundedReader<const char*> {
+  explicit Reader(const TVariant& x) : Reader(x.template as<JsonString>()) {}
+
+ private:
+  // the string may not be null-terminated
+  explicit Reader(JsonString s)
+      : BoundedReader<const char*>(s.c_str(), s.size()) {}
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
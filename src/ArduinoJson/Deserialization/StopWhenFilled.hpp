@@ -0,0 +1,31 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// Tells deserializeJson() to return as soon as it has read every path of
+// the filter, instead of reading the input to the end.
+// The rest of a stream is left unread (except, after a number, the character
+// that ends it), and the rest of the input is not validated.
+// It only applies when every path of the filter ends with true and contains
+// no wildcard and no array; otherwise the input is read to the end.
+class StopWhenFilled {
+ public:
+  explicit StopWhenFilled(bool enabled = true) : enabled_(enabled) {}
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+ private:
+  bool enabled_;
+};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,29 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// Tells deserializeJson() to check that the strings are well-formed UTF-8.
+// It returns DeserializationError::InvalidUtf8 if they're not.
+// The check runs while parsing, including on the strings that the filter
+// skips, so the input is only read once.
+class ValidateUtf8 {
+ public:
+  explicit ValidateUtf8(bool enabled = true) : enabled_(enabled) {}
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+ private:
+  bool enabled_;
+};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,35 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// Tells deserializeJson() to store the strings without escape sequences as
+// pointers to the input, instead of copying them to the memory pool.
+// It only applies to read-only inputs that are contiguous in RAM, like
+// const char* or std::string; the input must outlive the document.
+// These strings are not null-terminated, so is<const char*>() returns false.
+// as<const char*>() copies the string to the memory pool the first time you
+// call it on a JsonVariant or a JsonDocument; on a JsonVariantConst, which
+// can't allocate, it returns null. as<JsonString>() and as<std::string>()
+// never copy.
+// Keys are always copied.
+class ZeroCopy {
+ public:
+  explicit ZeroCopy(bool enabled = true) : enabled_(enabled) {}
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+ private:
+  bool enabled_;
+};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
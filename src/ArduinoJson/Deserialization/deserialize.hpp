@@ -6,8 +6,12 @@
 
 #include <ArduinoJson/Deserialization/DeserializationError.hpp>
 #include <ArduinoJson/Deserialization/DeserializationOptions.hpp>
+#include <ArduinoJson/Deserialization/Handler.hpp>
+#include <ArduinoJson/Deserialization/InSitu.hpp>
 #include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Memory/SlotCounter.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
+#include <ArduinoJson/StringStorage/StringCounter.hpp>
 #include <ArduinoJson/StringStorage/StringStorage.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
@@ -37,7 +41,7 @@ template <template <typename, typename> class TDeserializer, typename TStream,
           typename = typename enable_if<  // issue #1897
               !is_integral<typename first_or_void<Args...>::type>::value>::type>
 DeserializationError deserialize(JsonDocument& doc, TStream&& input,
-                                 Args... args) {
+                                 const Args&... args) {
   auto reader = makeReader(detail::forward<TStream>(input));
   auto data = VariantAttorney::getData(doc);
   auto pool = VariantAttorney::getPool(doc);
@@ -45,14 +49,14 @@ DeserializationError deserialize(JsonDocument& doc, TStream&& input,
   doc.clear();
   return makeDeserializer<TDeserializer>(pool, reader,
                                          makeStringStorage(input, pool))
-      .parse(*data, options.filter, options.nestingLimit);
+      .parse(*data, options);
 }
 
 template <template <typename, typename> class TDeserializer, typename TChar,
           typename Size, typename... Args,
           typename = typename enable_if<is_integral<Size>::value>::type>
 DeserializationError deserialize(JsonDocument& doc, TChar* input,
-                                 Size inputSize, Args... args) {
+                                 Size inputSize, const Args&... args) {
   auto reader = makeReader(input, size_t(inputSize));
   auto data = VariantAttorney::getData(doc);
   auto pool = VariantAttorney::getPool(doc);
@@ -60,7 +64,91 @@ DeserializationError deserialize(JsonDocument& doc, TChar* input,
   doc.clear();
   return makeDeserializer<TDeserializer>(pool, reader,
                                          makeStringStorage(input, pool))
-      .parse(*data, options.filter, options.nestingLimit);
+      .parse(*data, options);
+}
+
+// The string storage that deserialize() would use for this input
+template <typename TInput>
+struct StringStorageOf {
+  typedef decltype(makeStringStorage(declval<TInput&>(),
+                                     static_cast<MemoryPool*>(0))) type;
+};
+
+// Runs the deserializer with counters instead of a memory pool.
+// Returns the capacity that deserialize() needs, or 0 if it would fail for
+// another reason than the lack of memory.
+template <template <typename, typename> class TDeserializer, typename TReader,
+          typename TInput, typename... Args>
+size_t measureWithCounters(TReader reader, const Args&... args) {
+  typedef StringCounter<typename StringStorageOf<TInput>::type> storage_type;
+  auto options = makeDeserializationOptions(args...);
+  SlotCounter slots;
+  CountedStrings<> strings;
+  TDeserializer<TReader, storage_type> deserializer(0, reader,
+                                                    storage_type(&strings));
+  if (deserializer.measure(slots, options))
+    return 0;
+  return slots.bytes() + strings.bytes();
+}
+
+template <template <typename, typename> class TDeserializer, typename TStream,
+          typename... Args,
+          typename = typename enable_if<
+              !is_integral<typename first_or_void<Args...>::type>::value>::type>
+size_t measureDeserialize(TStream&& input, const Args&... args) {
+  auto reader = makeReader(detail::forward<TStream>(input));
+  return measureWithCounters<TDeserializer, decltype(reader),
+                             typename remove_reference<TStream>::type>(
+      reader, args...);
+}
+
+template <template <typename, typename> class TDeserializer, typename TChar,
+          typename Size, typename... Args,
+          typename = typename enable_if<is_integral<Size>::value>::type>
+size_t measureDeserialize(TChar* input, Size inputSize, const Args&... args) {
+  auto reader = makeReader(input, size_t(inputSize));
+  return measureWithCounters<TDeserializer, decltype(reader), TChar*>(
+      reader, args...);
+}
+
+// When the parser only stores the current string, in a buffer of
+// ARDUINOJSON_HANDLER_BUFFER_SIZE bytes, running out of memory means that
+// the string is too long
+inline DeserializationError::Code stringTooLongIfNoMemory(
+    DeserializationError::Code err) {
+  return err == DeserializationError::NoMemory
+             ? DeserializationError::StringTooLong
+             : err;
+}
+
+template <template <typename, typename> class TDeserializer, typename THandler,
+          typename TStream>
+DeserializationError deserializeToHandler(
+    THandler& handler, TStream&& input,
+    DeserializationOption::NestingLimit nestingLimit) {
+  auto reader = makeReader(detail::forward<TStream>(input));
+  // the strings only live during the call to the handler, so they share
+  // a small buffer on the stack
+  StaticMemoryPool<ARDUINOJSON_HANDLER_BUFFER_SIZE> pool;
+  return stringTooLongIfNoMemory(
+      makeDeserializer<TDeserializer>(&pool, reader,
+                                      makeStringStorage(input, &pool))
+          .parse(handler, nestingLimit)
+          .code());
+}
+
+template <template <typename, typename> class TDeserializer, typename THandler,
+          typename TChar>
+DeserializationError deserializeToHandler(
+    THandler& handler, TChar* input, size_t inputSize,
+    DeserializationOption::NestingLimit nestingLimit) {
+  auto reader = makeReader(input, inputSize);
+  StaticMemoryPool<ARDUINOJSON_HANDLER_BUFFER_SIZE> pool;
+  return stringTooLongIfNoMemory(
+      makeDeserializer<TDeserializer>(&pool, reader,
+                                      makeStringStorage(input, &pool))
+          .parse(handler, nestingLimit)
+          .code());
 }
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,44 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/InSitu.hpp>
+#include <ArduinoJson/Document/DynamicJsonDocument.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A DynamicJsonDocument that owns the container it parses in place, so the
+// strings that point to the container live as long as the document.
+// Move the payload into input(), then call deserializeJson(doc, doc.inSitu()).
+template <typename TContainer>
+class InSituJsonDocument : public DynamicJsonDocument {
+ public:
+  explicit InSituJsonDocument(size_t capa) : DynamicJsonDocument(capa) {}
+
+  // The copy would point to the container of the original
+  InSituJsonDocument(const InSituJsonDocument&) = delete;
+  InSituJsonDocument& operator=(const InSituJsonDocument&) = delete;
+
+  // Returns the container.
+  // Don't modify it while the document refers to it.
+  TContainer& input() {
+    return input_;
+  }
+
+  const TContainer& input() const {
+    return input_;
+  }
+
+  // Returns the container, wrapped for deserializeJson() or
+  // deserializeMsgPack().
+  InSitu<TContainer> inSitu() {
+    return InSitu<TContainer>(input_);
+  }
+
+ private:
+  TContainer input_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <ArduinoJson/Deserialization/ParseStack.hpp>
 #include <ArduinoJson/Deserialization/deserialize.hpp>
 #include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/JsonCharacters.hpp>
 #include <ArduinoJson/Json/Latch.hpp>
+#include <ArduinoJson/Json/StringScanner.hpp>
 #include <ArduinoJson/Json/Utf16.hpp>
 #include <ArduinoJson/Json/Utf8.hpp>
 #include <ArduinoJson/Memory/MemoryPool.hpp>
@@ -16,24 +19,52 @@
 #include <ArduinoJson/Polyfills/utility.hpp>
 #include <ArduinoJson/Variant/VariantData.hpp>
 
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+template <size_t capacity>
+class JsonExtractor;
+template <typename TReader>
+class JsonReader;
+template <typename TReader>
+class JsonLinesReader;
+class LazyJsonIterator;
+class LazyJsonValue;
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 template <typename TReader, typename TStringStorage>
 class JsonDeserializer {
+  template <size_t>
+  friend class ArduinoJson::JsonExtractor;
+  template <typename>
+  friend class ArduinoJson::JsonReader;
+  template <typename>
+  friend class ArduinoJson::JsonLinesReader;
+  friend class ArduinoJson::LazyJsonIterator;
+  friend class ArduinoJson::LazyJsonValue;
+
  public:
   JsonDeserializer(MemoryPool* pool, TReader reader,
                    TStringStorage stringStorage)
       : stringStorage_(stringStorage),
         foundSomething_(false),
+        assumeUniqueKeys_(false),
+        zeroCopy_(false),
+        validateUtf8_(false),
+        lazyNumbers_(false),
+        pathsToFill_(0),
+        filledPaths_(0),
         latch_(reader),
-        pool_(pool) {}
+        pool_(pool),
+        slotCounter_(0) {}
 
   template <typename TFilter>
-  DeserializationError parse(VariantData& variant, TFilter filter,
-                             DeserializationOption::NestingLimit nestingLimit) {
+  DeserializationError parse(VariantData& variant,
+                             const DeserializationOptions<TFilter>& options) {
     DeserializationError::Code err;
 
-    err = parseVariant(variant, filter, nestingLimit);
+    setOptions(options);
+    err = parseVariant(variant, options.filter, options.nestingLimit);
 
     if (!err && latch_.last() != 0 && !variant.isEnclosed()) {
       // We don't detect trailing characters earlier, so we need to check now
@@ -43,7 +74,56 @@ class JsonDeserializer {
     return err;
   }
 
+  // Parses without building the document: counts the slots in the
+  // SlotCounter, and the strings in the string storage
+  template <typename TFilter>
+  DeserializationError measure(SlotCounter& slots,
+                               const DeserializationOptions<TFilter>& options) {
+    VariantData scratch;
+    slotCounter_ = &slots;
+    return parse(scratch, options);
+  }
+
+  template <typename THandler>
+  DeserializationError parse(THandler& handler,
+                             DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    bool enclosed = current() == '[' || current() == '{';
+
+    err = emitVariant(handler, nestingLimit);
+
+    if (!err && latch_.last() != 0 && !enclosed) {
+      // We don't detect trailing characters earlier, so we need to check now
+      return DeserializationError::InvalidInput;
+    }
+
+    return err;
+  }
+
  private:
+  // Applies the options before parsing a value
+  template <typename TFilter>
+  void setOptions(const DeserializationOptions<TFilter>& options) {
+    assumeUniqueKeys_ = options.assumeUniqueKeys;
+    zeroCopy_ = options.zeroCopy;
+    validateUtf8_ = options.validateUtf8;
+    lazyNumbers_ = options.lazyNumbers;
+    pathsToFill_ = 0;
+    filledPaths_ = 0;
+    if (options.stopWhenFilled && !options.filter.countPaths(pathsToFill_))
+      pathsToFill_ = 0;
+  }
+
+  // Returns true if StopWhenFilled left the end of the value unread
+  bool stoppedEarly() const {
+    return pathsToFill_ && filledPaths_ == pathsToFill_;
+  }
+
   char current() {
     return latch_.current();
   }
@@ -59,61 +139,281 @@ class JsonDeserializer {
     return true;
   }
 
+  // Allocates a slot in the collection, or only counts it when measuring
+  VariantSlot* addSlot(CollectionData* collection) {
+    if (slotCounter_)
+      return slotCounter_->addSlot();
+    return collection->addSlot(pool_);
+  }
+
+  template <typename TFilter>
+  struct Frame {
+    CollectionData* collection;  // null when the collection is skipped
+    TFilter filter;
+    DeserializationOption::NestingLimit nestingLimit;
+    bool isObject;
+    size_t index;  // the index of the next element of an array
+  };
+
+  // The filter of an element; ElementFilterCursor also looks at its index
+  template <typename TFilter>
+  static auto elementFilter(const TFilter& filter, size_t index, int)
+      -> decltype(filter.element(index)) {
+    return filter.element(index);
+  }
+
+  template <typename TFilter>
+  static TFilter elementFilter(const TFilter& filter, size_t, long) {
+    return filter[0UL];
+  }
+
+  // Tells whether the elements must pass a predicate once parsed
+  template <typename TFilter>
+  static auto hasPredicate(const TFilter& filter, int)
+      -> decltype(filter.hasPredicate()) {
+    return filter.hasPredicate();
+  }
+
+  template <typename TFilter>
+  static bool hasPredicate(const TFilter&, long) {
+    return false;
+  }
+
+  template <typename TFilter>
+  static auto keepElement(const TFilter& filter, const VariantData* element,
+                          int) -> decltype(filter.keep(element)) {
+    return filter.keep(element);
+  }
+
+  template <typename TFilter>
+  static bool keepElement(const TFilter&, const VariantData*, long) {
+    return true;
+  }
+
   template <typename TFilter>
   DeserializationError::Code parseVariant(
       VariantData& variant, TFilter filter,
       DeserializationOption::NestingLimit nestingLimit) {
+    return parseValue(&variant, filter, nestingLimit);
+  }
+
+  DeserializationError::Code skipVariant(
+      DeserializationOption::NestingLimit nestingLimit) {
+    return parseValue(0, AllowAllFilter(), nestingLimit);
+  }
+
+  // Parses a value and all its children, without recursion.
+  // The value is skipped when target is null.
+  template <typename TFilter>
+  DeserializationError::Code parseValue(
+      VariantData* target, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
     DeserializationError::Code err;
+    ParseStack<Frame<TFilter> > stack;
 
-    err = skipSpacesAndComments();
-    if (err)
-      return err;
+    // The element that waits for the predicate, and how to remove it
+    CollectionData* pendingArray = 0;
+    VariantSlot* previousTail = 0;
+    MemoryPool::Checkpoint checkpoint = {0, 0, 0};
 
-    switch (current()) {
-      case '[':
-        if (filter.allowArray())
-          return parseArray(variant.toArray(), filter, nestingLimit);
-        else
-          return skipArray(nestingLimit);
+    for (;;) {
+      // 1 - Parse a value, or open a collection
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
 
-      case '{':
-        if (filter.allowObject())
-          return parseObject(variant.toObject(), filter, nestingLimit);
-        else
-          return skipObject(nestingLimit);
+      bool opened = false;
+      bool allowValue = target && filter.allowValue();
 
-      case '\"':
-      case '\'':
-        if (filter.allowValue())
-          return parseStringValue(variant);
-        else
-          return skipQuotedString();
+      switch (current()) {
+        case '[':
+        case '{': {
+          if (nestingLimit.reached())
+            return DeserializationError::TooDeep;
+
+          bool isObject = current() == '{';
+          CollectionData* collection = 0;
+          if (target && isObject && filter.allowObject())
+            collection = &target->toObject();
+          if (target && !isObject && filter.allowArray())
+            collection = &target->toArray();
+
+          // Skip opening bracket
+          move();
 
-      case 't':
-        if (filter.allowValue())
-          variant.setBoolean(true);
-        return skipKeyword("true");
+          // Skip spaces
+          err = skipSpacesAndComments();
+          if (err)
+            return err;
 
-      case 'f':
-        if (filter.allowValue())
-          variant.setBoolean(false);
-        return skipKeyword("false");
+          // Empty collection?
+          if (eat(isObject ? '}' : ']'))
+            break;
 
-      case 'n':
-        // the variant should already by null, except if the same object key was
-        // used twice, as in {"a":1,"a":null}
-        return skipKeyword("null");
+          Frame<TFilter> frame = {collection, filter, nestingLimit, isObject,
+                                  0};
+          if (!stack.push(frame))
+            return DeserializationError::NoMemory;
+          opened = true;
+          break;
+        }
+
+        case '\"':
+        case '\'':
+          if (allowValue)
+            err = parseStringValue(*target);
+          else
+            err = skipQuotedString();
+          break;
 
-      default:
-        if (filter.allowValue())
-          return parseNumericValue(variant);
+        case 't':
+          if (allowValue)
+            target->setBoolean(true);
+          err = skipKeyword("true");
+          break;
+
+        case 'f':
+          if (allowValue)
+            target->setBoolean(false);
+          err = skipKeyword("false");
+          break;
+
+        case 'n':
+          // the variant should already by null, except if the same object key
+          // was used twice, as in {"a":1,"a":null}
+          err = skipKeyword("null");
+          break;
+
+        default:
+          if (allowValue)
+            err = parseNumericValue(*target);
+          else
+            err = skipNumericValue();
+          break;
+      }
+
+      if (err)
+        return err;
+
+      // 2 - Close the collections that are complete
+      if (!opened) {
+        for (;;) {
+          if (stack.empty())
+            return DeserializationError::Ok;
+
+          // The element that waits for the predicate is complete?
+          if (pendingArray && stack.top().collection == pendingArray) {
+            VariantSlot* element = pendingArray->tail();
+            if (!keepElement(stack.top().filter, element->data(), 0)) {
+              // remove it, and give its memory to the next element
+              pendingArray->truncate(previousTail);
+              pool_->rollback(checkpoint);
+            }
+            pendingArray = 0;
+          }
+
+          // The values of the filter's paths are complete?
+          if (filledPaths_ == pathsToFill_ && pathsToFill_ &&
+              !stack.top().filter.allowValue())
+            return DeserializationError::Ok;
+
+          // Skip spaces
+          err = skipSpacesAndComments();
+          if (err)
+            return err;
+
+          // More values?
+          if (eat(stack.top().isObject ? '}' : ']')) {
+            stack.pop();
+            continue;
+          }
+          if (!eat(','))
+            return DeserializationError::InvalidInput;
+          break;
+        }
+      }
+
+      // 3 - Move to the next element or member
+      Frame<TFilter>& frame = stack.top();
+      nestingLimit = frame.nestingLimit.decrement();
+      target = 0;
+
+      if (frame.isObject) {
+        // Skip spaces
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        // Parse key
+        if (frame.collection)
+          err = parseKey();
         else
-          return skipNumericValue();
+          err = skipKey();
+        if (err)
+          return err;
+
+        // Skip spaces
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        // Colon
+        if (!eat(':'))
+          return DeserializationError::InvalidInput;
+
+        if (frame.collection) {
+          JsonString key = stringStorage_.str();
+
+          filter = frame.filter[key.c_str()];
+
+          if (filter.allow()) {
+            // looking for a previous member makes parsing quadratic;
+            // when measuring, there is none, so duplicate keys count twice
+            if (!assumeUniqueKeys_ && !slotCounter_)
+              target = frame.collection->getMember(adaptString(key.c_str()));
+            if (!target) {
+              // Save key in memory pool.
+              // This MUST be done before adding the slot.
+              key = stringStorage_.save();
+
+              // Allocate slot in object
+              VariantSlot* slot = addSlot(frame.collection);
+              if (!slot)
+                return DeserializationError::NoMemory;
+
+              slot->setKey(key);
+
+              target = slot->data();
+
+              // a path of the filter ends here
+              if (filter.allowValue() && !frame.filter.allowValue())
+                filledPaths_++;
+            }
+          }
+        }
+      } else if (frame.collection) {
+        filter = elementFilter(frame.filter, frame.index++, 0);
+
+        if (filter.allow()) {
+          // when measuring, the elements are not kept, so they all count
+          if (!slotCounter_ && hasPredicate(frame.filter, 0)) {
+            pendingArray = frame.collection;
+            previousTail = frame.collection->tail();
+            checkpoint = pool_->checkpoint();
+          }
+
+          // Allocate slot in array
+          target = slotData(addSlot(frame.collection));
+          if (!target)
+            return DeserializationError::NoMemory;
+        }
+      }
     }
   }
 
-  DeserializationError::Code skipVariant(
-      DeserializationOption::NestingLimit nestingLimit) {
+  template <typename THandler>
+  DeserializationError::Code emitVariant(
+      THandler& handler, DeserializationOption::NestingLimit nestingLimit) {
     DeserializationError::Code err;
 
     err = skipSpacesAndComments();
@@ -122,38 +422,61 @@ class JsonDeserializer {
 
     switch (current()) {
       case '[':
-        return skipArray(nestingLimit);
+        return emitArray(handler, nestingLimit);
 
       case '{':
-        return skipObject(nestingLimit);
+        return emitObject(handler, nestingLimit);
 
       case '\"':
       case '\'':
-        return skipQuotedString();
+        stringStorage_.startString();
+        err = parseQuotedString();
+        if (err)
+          return err;
+        handler.onString(stringStorage_.str());
+        return DeserializationError::Ok;
 
       case 't':
-        return skipKeyword("true");
+        err = skipKeyword("true");
+        if (!err)
+          handler.onBool(true);
+        return err;
 
       case 'f':
-        return skipKeyword("false");
+        err = skipKeyword("false");
+        if (!err)
+          handler.onBool(false);
+        return err;
 
       case 'n':
-        return skipKeyword("null");
+        err = skipKeyword("null");
+        if (!err)
+          handler.onNull();
+        return err;
 
-      default:
-        return skipNumericValue();
+      default: {
+        VariantData value;
+        err = parseNumericValue(value);
+        if (err)
+          return err;
+        HandlerEmitter<THandler> emitter(handler);
+        value.accept(emitter);
+        return DeserializationError::Ok;
+      }
     }
   }
 
-  template <typename TFilter>
-  DeserializationError::Code parseArray(
-      CollectionData& array, TFilter filter,
-      DeserializationOption::NestingLimit nestingLimit) {
+  template <typename THandler>
+  DeserializationError::Code emitArray(
+      THandler& handler, DeserializationOption::NestingLimit nestingLimit) {
     DeserializationError::Code err;
 
     if (nestingLimit.reached())
       return DeserializationError::TooDeep;
 
+    if (!handler.onArrayStart())
+      return skipVariant(nestingLimit);
+
     // Skip opening braket
     ARDUINOJSON_ASSERT(current() == '[');
     move();
@@ -164,82 +487,42 @@ class JsonDeserializer {
       return err;
 
     // Empty array?
-    if (eat(']'))
-      return DeserializationError::Ok;
-
-    TFilter memberFilter = filter[0UL];
-
-    // Read each value
-    for (;;) {
-      if (memberFilter.allow()) {
-        // Allocate slot in array
-        VariantData* value = array.addElement(pool_);
-        if (!value)
-          return DeserializationError::NoMemory;
-
+    if (!eat(']')) {
+      // Read each value
+      for (;;) {
         // 1 - Parse value
-        err = parseVariant(*value, memberFilter, nestingLimit.decrement());
+        err = emitVariant(handler, nestingLimit.decrement());
         if (err)
           return err;
-      } else {
-        err = skipVariant(nestingLimit.decrement());
+
+        // 2 - Skip spaces
+        err = skipSpacesAndComments();
         if (err)
           return err;
-      }
 
-      // 2 - Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
-
-      // 3 - More values?
-      if (eat(']'))
-        return DeserializationError::Ok;
-      if (!eat(','))
-        return DeserializationError::InvalidInput;
+        // 3 - More values?
+        if (eat(']'))
+          break;
+        if (!eat(','))
+          return DeserializationError::InvalidInput;
+      }
     }
-  }
-
-  DeserializationError::Code skipArray(
-      DeserializationOption::NestingLimit nestingLimit) {
-    DeserializationError::Code err;
 
-    if (nestingLimit.reached())
-      return DeserializationError::TooDeep;
-
-    // Skip opening braket
-    ARDUINOJSON_ASSERT(current() == '[');
-    move();
-
-    // Read each value
-    for (;;) {
-      // 1 - Skip value
-      err = skipVariant(nestingLimit.decrement());
-      if (err)
-        return err;
-
-      // 2 - Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
-
-      // 3 - More values?
-      if (eat(']'))
-        return DeserializationError::Ok;
-      if (!eat(','))
-        return DeserializationError::InvalidInput;
-    }
+    handler.onArrayEnd();
+    return DeserializationError::Ok;
   }
 
-  template <typename TFilter>
-  DeserializationError::Code parseObject(
-      CollectionData& object, TFilter filter,
-      DeserializationOption::NestingLimit nestingLimit) {
+  template <typename THandler>
+  DeserializationError::Code emitObject(
+      THandler& handler, DeserializationOption::NestingLimit nestingLimit) {
     DeserializationError::Code err;
 
     if (nestingLimit.reached())
       return DeserializationError::TooDeep;
 
+    if (!handler.onObjectStart())
+      return skipVariant(nestingLimit);
+
     // Skip opening brace
     ARDUINOJSON_ASSERT(current() == '{');
     move();
@@ -250,130 +533,51 @@ class JsonDeserializer {
       return err;
 
     // Empty object?
-    if (eat('}'))
-      return DeserializationError::Ok;
-
-    // Read each key value pair
-    for (;;) {
-      // Parse key
-      err = parseKey();
-      if (err)
-        return err;
-
-      // Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
-
-      // Colon
-      if (!eat(':'))
-        return DeserializationError::InvalidInput;
-
-      JsonString key = stringStorage_.str();
-
-      TFilter memberFilter = filter[key.c_str()];
-
-      if (memberFilter.allow()) {
-        VariantData* variant = object.getMember(adaptString(key.c_str()));
-        if (!variant) {
-          // Save key in memory pool.
-          // This MUST be done before adding the slot.
-          key = stringStorage_.save();
-
-          // Allocate slot in object
-          VariantSlot* slot = object.addSlot(pool_);
-          if (!slot)
-            return DeserializationError::NoMemory;
+    if (!eat('}')) {
+      // Read each key value pair
+      for (;;) {
+        // Parse key
+        err = parseKey();
+        if (err)
+          return err;
 
-          slot->setKey(key);
+        // Skip spaces
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
 
-          variant = slot->data();
-        }
+        // Colon
+        if (!eat(':'))
+          return DeserializationError::InvalidInput;
 
         // Parse value
-        err = parseVariant(*variant, memberFilter, nestingLimit.decrement());
+        if (handler.onKey(stringStorage_.str()))
+          err = emitVariant(handler, nestingLimit.decrement());
+        else
+          err = skipVariant(nestingLimit.decrement());
         if (err)
           return err;
-      } else {
-        err = skipVariant(nestingLimit.decrement());
+
+        // Skip spaces
+        err = skipSpacesAndComments();
         if (err)
           return err;
-      }
 
-      // Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
-
-      // More keys/values?
-      if (eat('}'))
-        return DeserializationError::Ok;
-      if (!eat(','))
-        return DeserializationError::InvalidInput;
+        // More keys/values?
+        if (eat('}'))
+          break;
+        if (!eat(','))
+          return DeserializationError::InvalidInput;
 
-      // Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
+        // Skip spaces
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+      }
     }
-  }
-
-  DeserializationError::Code skipObject(
-      DeserializationOption::NestingLimit nestingLimit) {
-    DeserializationError::Code err;
-
-    if (nestingLimit.reached())
-      return DeserializationError::TooDeep;
-
-    // Skip opening brace
-    ARDUINOJSON_ASSERT(current() == '{');
-    move();
-
-    // Skip spaces
-    err = skipSpacesAndComments();
-    if (err)
-      return err;
-
-    // Empty object?
-    if (eat('}'))
-      return DeserializationError::Ok;
-
-    // Read each key value pair
-    for (;;) {
-      // Skip key
-      err = skipKey();
-      if (err)
-        return err;
-
-      // Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
-
-      // Colon
-      if (!eat(':'))
-        return DeserializationError::InvalidInput;
-
-      // Skip value
-      err = skipVariant(nestingLimit.decrement());
-      if (err)
-        return err;
-
-      // Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
 
-      // More keys/values?
-      if (eat('}'))
-        return DeserializationError::Ok;
-      if (!eat(','))
-        return DeserializationError::InvalidInput;
-
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
-    }
+    handler.onObjectEnd();
+    return DeserializationError::Ok;
   }
 
   DeserializationError::Code parseKey() {
@@ -388,6 +592,9 @@ class JsonDeserializer {
   DeserializationError::Code parseStringValue(VariantData& variant) {
     DeserializationError::Code err;
 
+    if (zeroCopy_ && linkStringValue(variant))
+      return DeserializationError::Ok;
+
     stringStorage_.startString();
 
     err = parseQuotedString();
@@ -399,15 +606,53 @@ class JsonDeserializer {
     return DeserializationError::Ok;
   }
 
+  // Stores a string without escape sequences as a pointer to the input.
+  // Returns false, without consuming anything, if the string needs a copy.
+  bool linkStringValue(VariantData& variant) {
+    // StringMover overwrites the input behind the reading position
+    if (!CopiesStrings<TStringStorage>::value)
+      return false;
+
+    const char* begin = latch_.begin();
+    if (!begin)  // not a contiguous input
+      return false;
+
+    const char stopChar = *begin++;
+    const char* end = scanStringRun(begin, latch_.end(), stopChar);
+    if (end == latch_.end() || *end != stopChar)
+      return false;
+
+    // let parseQuotedString() report the error
+    Utf8::Validator utf8;
+    if (validateUtf8_ && (!utf8.append(begin, end) || !utf8.complete()))
+      return false;
+
+    variant.setLinkedSlice(begin, size_t(end - begin));
+    latch_.seek(end);
+    move();  // skip the closing quote
+    return true;
+  }
+
   DeserializationError::Code parseQuotedString() {
 #if ARDUINOJSON_DECODE_UNICODE
     Utf16::Codepoint codepoint;
     DeserializationError::Code err;
 #endif
+    Utf8::Validator utf8;
     const char stopChar = current();
 
     move();
     for (;;) {
+      // On contiguous inputs, copy the plain characters in one call
+      const char* runStart = latch_.begin();
+      const char* runEnd = scanStringRun(runStart, latch_.end(), stopChar);
+      if (runEnd != runStart) {
+        if (validateUtf8_ && !utf8.append(runStart, runEnd))
+          return DeserializationError::InvalidUtf8;
+        stringStorage_.append(runStart, size_t(runEnd - runStart));
+        latch_.seek(runEnd);
+      }
+
       char c = current();
       move();
       if (c == stopChar)
@@ -416,6 +661,10 @@ class JsonDeserializer {
       if (c == '\0')
         return DeserializationError::IncompleteInput;
 
+      // escape sequences are ASCII, so they can't complete a character
+      if (validateUtf8_ && !utf8.append(c))
+        return DeserializationError::InvalidUtf8;
+
       if (c == '\\') {
         c = current();
 
@@ -447,6 +696,9 @@ class JsonDeserializer {
       stringStorage_.append(c);
     }
 
+    if (validateUtf8_ && !utf8.complete())
+      return DeserializationError::InvalidUtf8;
+
     if (!stringStorage_.isValid())
       return DeserializationError::NoMemory;
 
@@ -482,22 +734,37 @@ class JsonDeserializer {
   }
 
   DeserializationError::Code skipQuotedString() {
+    Utf8::Validator utf8;
     const char stopChar = current();
 
     move();
     for (;;) {
+      // On contiguous inputs, jump over the plain characters
+      const char* runStart = latch_.begin();
+      const char* runEnd = scanStringRun(runStart, latch_.end(), stopChar);
+      if (runEnd != runStart) {
+        if (validateUtf8_ && !utf8.append(runStart, runEnd))
+          return DeserializationError::InvalidUtf8;
+        latch_.seek(runEnd);
+      }
+
       char c = current();
       move();
       if (c == stopChar)
         break;
       if (c == '\0')
         return DeserializationError::IncompleteInput;
+      if (validateUtf8_ && !utf8.append(c))
+        return DeserializationError::InvalidUtf8;
       if (c == '\\') {
         if (current() != '\0')
           move();
       }
     }
 
+    if (validateUtf8_ && !utf8.complete())
+      return DeserializationError::InvalidUtf8;
+
     return DeserializationError::Ok;
   }
 
@@ -511,19 +778,52 @@ class JsonDeserializer {
   }
 
   DeserializationError::Code parseNumericValue(VariantData& result) {
-    uint8_t n = 0;
+    // StringMover can't terminate a number that ends the input
+    if (lazyNumbers_ && CopiesStrings<TStringStorage>::value)
+      return saveNumericValue(result);
+
+    // the number is parsed directly from the input, so it must be followed by
+    // a character that cannot be part of a number
+    if (!parseNumber(latch_, result) || canBeInNumber(current()))
+      return DeserializationError::InvalidInput;
+
+    return DeserializationError::Ok;
+  }
+
+  // Stores the text of the number, to parse it on demand
+  DeserializationError::Code saveNumericValue(VariantData& result) {
+    stringStorage_.startString();
+
+    // On contiguous inputs, copy the number in one call
+    const char* begin = latch_.begin();
+    if (begin) {
+      const char* end = begin;
+      while (end < latch_.end() && canBeInNumber(*end))
+        end++;
+      stringStorage_.append(begin, size_t(end - begin));
+      latch_.seek(end);
+    }
 
     char c = current();
-    while (canBeInNumber(c) && n < 63) {
+    while (canBeInNumber(c)) {
+      stringStorage_.append(c);
       move();
-      buffer_[n++] = c;
       c = current();
     }
-    buffer_[n] = 0;
 
-    if (!parseNumber(buffer_, result))
-      return DeserializationError::InvalidInput;
+    if (!stringStorage_.isValid())
+      return DeserializationError::NoMemory;
+
+    JsonString text = stringStorage_.str();
+    if (isStrictJsonNumber(text.c_str())) {
+      result.setRawNumber(stringStorage_.save());
+      return DeserializationError::Ok;
+    }
 
+    // NaN, Infinity, and the lenient forms are converted now, so the
+    // serializer writes valid JSON; the text is discarded
+    if (!parseNumber(text.c_str(), result))
+      return DeserializationError::InvalidInput;
     return DeserializationError::Ok;
   }
 
@@ -551,35 +851,6 @@ class JsonDeserializer {
     return DeserializationError::Ok;
   }
 
-  static inline bool isBetween(char c, char min, char max) {
-    return min <= c && c <= max;
-  }
-
-  static inline bool canBeInNumber(char c) {
-    return isBetween(c, '0', '9') || c == '+' || c == '-' || c == '.' ||
-#if ARDUINOJSON_ENABLE_NAN || ARDUINOJSON_ENABLE_INFINITY
-           isBetween(c, 'A', 'Z') || isBetween(c, 'a', 'z');
-#else
-           c == 'e' || c == 'E';
-#endif
-  }
-
-  static inline bool canBeInNonQuotedString(char c) {
-    return isBetween(c, '0', '9') || isBetween(c, '_', 'z') ||
-           isBetween(c, 'A', 'Z');
-  }
-
-  static inline bool isQuote(char c) {
-    return c == '\'' || c == '\"';
-  }
-
-  static inline uint8_t decodeHex(char c) {
-    if (c < 'A')
-      return uint8_t(c - '0');
-    c = char(c & ~0x20);  // uppercase
-    return uint8_t(c - 'A' + 10);
-  }
-
   DeserializationError::Code skipSpacesAndComments() {
     for (;;) {
       switch (current()) {
@@ -661,11 +932,15 @@ class JsonDeserializer {
 
   TStringStorage stringStorage_;
   bool foundSomething_;
+  bool assumeUniqueKeys_;
+  bool zeroCopy_;
+  bool validateUtf8_;
+  bool lazyNumbers_;
+  size_t pathsToFill_;  // 0 means "read to the end"
+  size_t filledPaths_;
   Latch<TReader> latch_;
   MemoryPool* pool_;
-  char buffer_[64];  // using a member instead of a local variable because it
-                     // ended in the recursive path after compiler inlined the
-                     // code
+  SlotCounter* slotCounter_;  // not null when measuring
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -690,4 +965,70 @@ DeserializationError deserializeJson(JsonDocument& doc, TChar* input,
                                        detail::forward<Args>(args)...);
 }
 
+// Returns the capacity that deserializeJson() needs for this input, with
+// the same filter and options, without building a document.
+// Returns 0 if the input is invalid, or if a string doesn't fit in the heap.
+// The result is exact, except that duplicate keys and the predicate of
+// ElementFilter make it larger, and so does a heap too small to keep the
+// strings to recognize the duplicates.
+// It consumes streams, so measure a buffer and deserialize the same buffer.
+template <typename... Args>
+size_t measureDeserializeJson(Args&&... args) {
+  using namespace detail;
+  return measureDeserialize<JsonDeserializer>(detail::forward<Args>(args)...);
+}
+
+// Returns the capacity that deserializeJson() needs for this input, with
+// the same filter and options, without building a document.
+template <typename TChar, typename... Args>
+size_t measureDeserializeJson(TChar* input, Args&&... args) {
+  using namespace detail;
+  return measureDeserialize<JsonDeserializer>(input,
+                                              detail::forward<Args>(args)...);
+}
+
+// Parses a JSON input and calls the handler for each token, without building
+// a document.
+// Strings longer than ARDUINOJSON_HANDLER_BUFFER_SIZE - 1 fail with
+// StringTooLong, unless the input is writable (char*).
+template <typename THandler, typename TInput,
+          typename = typename detail::enable_if<
+              detail::IsHandler<THandler>::value>::type>
+DeserializationError deserializeJson(
+    THandler& handler, TInput&& input,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return deserializeToHandler<JsonDeserializer>(
+      handler, detail::forward<TInput>(input), nestingLimit);
+}
+
+// Parses a JSON input and calls the handler for each token, without building
+// a document.
+// Strings longer than ARDUINOJSON_HANDLER_BUFFER_SIZE - 1 fail with
+// StringTooLong, unless the input is writable (char*).
+template <typename THandler, typename TChar,
+          typename = typename detail::enable_if<
+              detail::IsHandler<THandler>::value>::type>
+DeserializationError deserializeJson(
+    THandler& handler, TChar* input,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return deserializeToHandler<JsonDeserializer>(handler, input, nestingLimit);
+}
+
+// Parses a JSON input and calls the handler for each token, without building
+// a document.
+// Strings longer than ARDUINOJSON_HANDLER_BUFFER_SIZE - 1 fail with
+// StringTooLong, unless the input is writable (char*).
+template <typename THandler, typename TChar,
+          typename = typename detail::enable_if<
+              detail::IsHandler<THandler>::value>::type>
+DeserializationError deserializeJson(
+    THandler& handler, TChar* input, size_t inputSize,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return deserializeToHandler<JsonDeserializer>(handler, input, inputSize,
+                                                nestingLimit);
+}
+
 ARDUINOJSON_END_PUBLIC_NAMESPACE
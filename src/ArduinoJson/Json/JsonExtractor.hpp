@@ -0,0 +1,407 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+#include <ArduinoJson/StringStorage/StringCopier.hpp>
+
+#include <string.h>  // memcmp
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Tells whether an output refers to the extracted value, in which case the
+// value must live in the pool of the document.
+template <typename T>
+struct IsReferenceOutput {
+  static const bool value =
+      is_same<T, JsonVariant>::value || is_same<T, JsonVariantConst>::value ||
+      is_same<T, JsonArray>::value || is_same<T, JsonArrayConst>::value ||
+      is_same<T, JsonObject>::value || is_same<T, JsonObjectConst>::value;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Extracts several values from a JSON input in a single pass.
+// The paths are either JSON Pointers ("/sensor/values/0") or dotted paths
+// ("sensor.values.0"). They are compiled into a tree, so the members that
+// match no path are skipped without being parsed.
+// The capacity is the number of nodes in the tree, i.e. the number of
+// distinct path segments.
+// The paths are not copied, so they must outlive the extractor.
+template <size_t capacity>
+class JsonExtractor {
+  static_assert(capacity < 255, "JsonExtractor's capacity is too large");
+
+ public:
+  JsonExtractor() : size_(1) {}
+
+  // Adds a path and the variable that receives the value.
+  // The output can be any type supported by JsonVariant::as<T>().
+  // Returns false if there is not enough room for the path.
+  template <typename T>
+  bool add(const char* path, T& output) {
+    uint8_t node = 0;
+    bool escaped = *path == '/';
+    char separator = escaped ? '/' : '.';
+
+    // values that the output refers to must be stored in the pool, as well as
+    // their ancestors, since they are parsed as a whole
+    bool reference = detail::IsReferenceOutput<T>::value;
+    if (reference)
+      nodes_[0].needsSlot = true;
+
+    if (*path) {
+      const char* segment = escaped ? path + 1 : path;
+      for (;;) {
+        const char* end = segment;
+        while (*end && *end != separator)
+          end++;
+        node = findOrAddChild(node, segment, size_t(end - segment), escaped);
+        if (!node)
+          return false;
+        if (reference)
+          nodes_[node].needsSlot = true;
+        if (!*end)
+          break;
+        segment = end + 1;
+      }
+    }
+
+    nodes_[node].output = &output;
+    nodes_[node].assign = assignOutput<T>;
+    return true;
+  }
+
+  // Tells whether the last call to extract() found the specified path.
+  bool found(const char* path) const {
+    uint8_t node = 0;
+    bool escaped = *path == '/';
+    char separator = escaped ? '/' : '.';
+
+    if (*path) {
+      const char* segment = escaped ? path + 1 : path;
+      for (;;) {
+        const char* end = segment;
+        while (*end && *end != separator)
+          end++;
+        node = findChild(node, segment, size_t(end - segment));
+        if (!node)
+          return false;
+        if (!*end)
+          break;
+        segment = end + 1;
+      }
+    }
+
+    return nodes_[node].found;
+  }
+
+  // Parses a JSON input and fills the outputs of the paths that it contains.
+  // The outputs of the missing paths are left untouched.
+  // The strings and the referenced values are stored in the document.
+  template <typename TInput>
+  DeserializationError extract(
+      JsonDocument& doc, TInput&& input,
+      DeserializationOption::NestingLimit nestingLimit = {}) {
+    return extractFrom(doc,
+                       detail::makeReader(detail::forward<TInput>(input)),
+                       nestingLimit);
+  }
+
+  // Parses a JSON input and fills the outputs of the paths that it contains.
+  // The outputs of the missing paths are left untouched.
+  // The strings and the referenced values are stored in the document.
+  template <typename TChar>
+  DeserializationError extract(
+      JsonDocument& doc, TChar* input,
+      DeserializationOption::NestingLimit nestingLimit = {}) {
+    return extractFrom(doc, detail::makeReader(input), nestingLimit);
+  }
+
+  // Parses a JSON input and fills the outputs of the paths that it contains.
+  // The outputs of the missing paths are left untouched.
+  // The strings and the referenced values are stored in the document.
+  template <typename TChar>
+  DeserializationError extract(
+      JsonDocument& doc, TChar* input, size_t inputSize,
+      DeserializationOption::NestingLimit nestingLimit = {}) {
+    return extractFrom(doc, detail::makeReader(input, inputSize),
+                       nestingLimit);
+  }
+
+ private:
+  typedef void (*assign_function)(void* output, detail::VariantData* data,
+                                  detail::MemoryPool* pool);
+
+  struct Node {
+    Node()
+        : segment(0),
+          segmentSize(0),
+          escaped(false),
+          firstChild(0),
+          nextSibling(0),
+          needsSlot(false),
+          found(false),
+          output(0),
+          assign(0) {}
+
+    const char* segment;
+    size_t segmentSize;
+    bool escaped;  // the segment uses JSON Pointer's ~0 and ~1
+    uint8_t firstChild;
+    uint8_t nextSibling;
+    bool needsSlot;  // an output refers to this value
+    bool found;
+    void* output;
+    assign_function assign;
+  };
+
+  template <typename T>
+  static void assignOutput(void* output, detail::VariantData* data,
+                           detail::MemoryPool* pool) {
+    *static_cast<T*>(output) = JsonVariant(pool, data).as<T>();
+  }
+
+  template <typename TReader>
+  DeserializationError extractFrom(JsonDocument& doc, TReader reader,
+                                   DeserializationOption::NestingLimit limit) {
+    using namespace detail;
+
+    doc.clear();
+    for (uint8_t i = 0; i < size_; i++)
+      nodes_[i].found = false;
+
+    MemoryPool* pool = VariantAttorney::getPool(doc);
+    JsonDeserializer<TReader, StringCopier> parser(pool, reader,
+                                                   StringCopier(pool));
+
+    DeserializationError::Code err = parser.skipSpacesAndComments();
+    if (err)
+      return err;
+
+    bool enclosed = parser.current() == '[' || parser.current() == '{';
+
+    err = extractValue(parser, 0, VariantAttorney::getData(doc), pool, limit);
+
+    if (!err && parser.latch_.last() != 0 && !enclosed) {
+      // We don't detect trailing characters earlier, so we need to check now
+      return DeserializationError::InvalidInput;
+    }
+
+    return err;
+  }
+
+  // Parses the value if a path ends at this node, scans the collection if
+  // paths go through it, or skips it.
+  template <typename TParser>
+  DeserializationError::Code extractValue(
+      TParser& parser, uint8_t node, detail::VariantData* root,
+      detail::MemoryPool* pool, DeserializationOption::NestingLimit limit) {
+    using namespace detail;
+
+    DeserializationError::Code err;
+
+    if (nodes_[node].output) {
+      // the value is needed, parse it
+      VariantData local;
+      VariantData* data = nodes_[node].needsSlot ? root->addElement(pool)
+                                                 : &local;
+      if (!data)
+        return DeserializationError::NoMemory;
+      err = parser.parseVariant(*data, AllowAllFilter(), limit);
+      if (err)
+        return err;
+      assignFrom(node, data, pool);
+      return DeserializationError::Ok;
+    }
+
+    err = parser.skipSpacesAndComments();
+    if (err)
+      return err;
+
+    bool isObject = parser.current() == '{';
+    if (!nodes_[node].firstChild || (!isObject && parser.current() != '['))
+      return parser.skipVariant(limit);
+
+    if (limit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening bracket
+    parser.move();
+
+    // Skip spaces
+    err = parser.skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty collection?
+    if (parser.eat(isObject ? '}' : ']'))
+      return DeserializationError::Ok;
+
+    for (size_t index = 0;; index++) {
+      uint8_t child;
+
+      if (isObject) {
+        // Parse key
+        err = parser.parseKey();
+        if (err)
+          return err;
+
+        // Skip spaces
+        err = parser.skipSpacesAndComments();
+        if (err)
+          return err;
+
+        // Colon
+        if (!parser.eat(':'))
+          return DeserializationError::InvalidInput;
+
+        child = findChild(node, parser.stringStorage_.str());
+      } else {
+        child = findChild(node, index);
+      }
+
+      // Parse or skip value
+      if (child)
+        err = extractValue(parser, child, root, pool, limit.decrement());
+      else
+        err = parser.skipVariant(limit.decrement());
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = parser.skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More values?
+      if (parser.eat(isObject ? '}' : ']'))
+        return DeserializationError::Ok;
+      if (!parser.eat(','))
+        return DeserializationError::InvalidInput;
+
+      // Skip spaces
+      err = parser.skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+
+  // Fills the outputs of this node and its descendants from a parsed value.
+  void assignFrom(uint8_t node, detail::VariantData* data,
+                  detail::MemoryPool* pool) {
+    if (!data)
+      return;
+
+    if (nodes_[node].output) {
+      nodes_[node].assign(nodes_[node].output, data, pool);
+      nodes_[node].found = true;
+    }
+
+    for (uint8_t child = nodes_[node].firstChild; child;
+         child = nodes_[child].nextSibling) {
+      detail::VariantData* value = 0;
+      if (data->isObject()) {
+        for (detail::VariantSlot* slot = data->asObject()->head(); slot;
+             slot = slot->next()) {
+          if (segmentEquals(child, JsonString(slot->key()))) {
+            value = slot->data();
+            break;
+          }
+        }
+      } else {
+        size_t index;
+        if (parseIndex(child, index))
+          value = data->getElement(index);
+      }
+      assignFrom(child, value, pool);
+    }
+  }
+
+  uint8_t findChild(uint8_t node, JsonString key) const {
+    for (uint8_t child = nodes_[node].firstChild; child;
+         child = nodes_[child].nextSibling) {
+      if (segmentEquals(child, key))
+        return child;
+    }
+    return 0;
+  }
+
+  uint8_t findChild(uint8_t node, size_t index) const {
+    for (uint8_t child = nodes_[node].firstChild; child;
+         child = nodes_[child].nextSibling) {
+      size_t childIndex;
+      if (parseIndex(child, childIndex) && childIndex == index)
+        return child;
+    }
+    return 0;
+  }
+
+  uint8_t findChild(uint8_t node, const char* segment, size_t size) const {
+    for (uint8_t child = nodes_[node].firstChild; child;
+         child = nodes_[child].nextSibling) {
+      if (nodes_[child].segmentSize == size &&
+          !memcmp(nodes_[child].segment, segment, size))
+        return child;
+    }
+    return 0;
+  }
+
+  uint8_t findOrAddChild(uint8_t node, const char* segment, size_t size,
+                         bool escaped) {
+    uint8_t child = findChild(node, segment, size);
+    if (child)
+      return child;
+    if (size_ >= capacity)
+      return 0;
+    child = size_++;
+    nodes_[child] = Node();
+    nodes_[child].segment = segment;
+    nodes_[child].segmentSize = size;
+    nodes_[child].escaped = escaped;
+    nodes_[child].nextSibling = nodes_[node].firstChild;
+    nodes_[node].firstChild = child;
+    return child;
+  }
+
+  // Compares the segment with a key, decoding JSON Pointer's escape sequences
+  bool segmentEquals(uint8_t node, JsonString key) const {
+    const char* s = nodes_[node].segment;
+    const char* end = s + nodes_[node].segmentSize;
+    size_t i = 0;
+    while (s < end) {
+      char c = *s++;
+      if (nodes_[node].escaped && c == '~' && s < end) {
+        c = *s++ == '0' ? '~' : '/';
+      }
+      if (i >= key.size() || key.c_str()[i] != c)
+        return false;
+      i++;
+    }
+    return i == key.size();
+  }
+
+  bool parseIndex(uint8_t node, size_t& index) const {
+    const char* s = nodes_[node].segment;
+    const char* end = s + nodes_[node].segmentSize;
+    if (s == end)
+      return false;
+    index = 0;
+    for (; s < end; s++) {
+      if (*s < '0' || *s > '9')
+        return false;
+      index = index * 10 + size_t(*s - '0');
+    }
+    return true;
+  }
+
+  Node nodes_[capacity];
+  uint8_t size_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,116 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Reads a sequence of JSON values, like JSON Lines (NDJSON) or concatenated
+// JSON, one value at a time.
+// Use makeJsonLinesReader() to create one; the input must outlive the reader.
+// Unlike calling deserializeJson() in a loop, it keeps the character that
+// follows each value, so nothing is lost between two values.
+template <typename TReader>
+class JsonLinesReader {
+ public:
+  JsonLinesReader(TReader reader)
+      : parser_(0, reader, detail::StringCopier(0)) {}
+
+  // Parses the next value, filters, and puts the result in a JsonDocument.
+  // Returns EmptyInput when there are no more values.
+  // With StopWhenFilled, the rest of the line is skipped once the filter is
+  // filled, so the next value must start on a new line.
+  // After an error, the rest of the line is skipped too, so the next call
+  // reads the following line.
+  template <typename... Args>
+  DeserializationError read(JsonDocument& doc, const Args&... args) {
+    auto data = detail::VariantAttorney::getData(doc);
+    auto pool = detail::VariantAttorney::getPool(doc);
+    auto options = detail::makeDeserializationOptions(args...);
+    doc.clear();
+
+    // reuse the reader and the latch, but write to this document
+    parser_.pool_ = pool;
+    parser_.stringStorage_ = detail::StringCopier(pool);
+    parser_.foundSomething_ = false;
+    parser_.setOptions(options);
+
+    // unlike deserializeJson(), anything can follow the value
+    DeserializationError::Code err =
+        parser_.parseVariant(*data, options.filter, options.nestingLimit);
+
+    if (err ? err != DeserializationError::EmptyInput
+            : parser_.stoppedEarly())
+      skipLine();
+    return err;
+  }
+
+  // Returns the number of bytes consumed from the input so far.
+  // After read(), it's the position of the first byte after the value.
+  size_t offset() const {
+    return parser_.latch_.position();
+  }
+
+ private:
+  void skipLine() {
+    for (;;) {
+      char c = parser_.current();
+      if (c == 0)
+        return;
+      parser_.move();
+      if (c == '\n')
+        return;
+    }
+  }
+
+  detail::JsonDeserializer<TReader, detail::StringCopier> parser_;
+};
+
+// Creates a JsonLinesReader for the specified input.
+template <typename TInput>
+JsonLinesReader<detail::Reader<typename detail::remove_reference<TInput>::type>>
+makeJsonLinesReader(TInput&& input) {
+  return {detail::makeReader(detail::forward<TInput>(input))};
+}
+
+// Creates a JsonLinesReader for the specified input.
+template <typename TChar>
+JsonLinesReader<detail::Reader<TChar*>> makeJsonLinesReader(TChar* input) {
+  return {detail::makeReader(input)};
+}
+
+// Creates a JsonLinesReader for the specified input.
+template <typename TChar>
+JsonLinesReader<detail::BoundedReader<TChar*>> makeJsonLinesReader(
+    TChar* input, size_t inputSize) {
+  return {detail::makeReader(input, inputSize)};
+}
+
+// Splits a JSON Lines buffer into (at most) count chunks that end with a
+// newline, so each chunk can be parsed independently, for example by a worker
+// thread with its own JsonDocument and JsonLinesReader.
+// Calls callback(index, chunk, chunkSize) for each non-empty chunk, in order.
+// Returns the number of chunks.
+template <typename TCallback>
+size_t splitJsonLines(const char* input, size_t inputSize, size_t count,
+                      TCallback callback) {
+  size_t index = 0;
+  size_t begin = 0;
+  for (size_t i = 1; i <= count && begin < inputSize; i++) {
+    size_t end = i == count ? inputSize : inputSize / count * i;
+    if (end < begin)
+      end = begin;
+    // extend the chunk to the end of the line
+    while (end < inputSize && (end == 0 || input[end - 1] != '\n'))
+      end++;
+    if (end > begin)
+      callback(index++, input + begin, end - begin);
+    begin = end;
+  }
+  return index;
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
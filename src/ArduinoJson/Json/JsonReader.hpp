@@ -0,0 +1,307 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/JsonToken.hpp>
+#include <ArduinoJson/Deserialization/ParseStack.hpp>
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+#include <ArduinoJson/StringStorage/StringBuffer.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Reads a JSON input one token at a time, without building a document.
+// Use makeJsonReader() to create one; the input must outlive the reader.
+template <typename TReader>
+class JsonReader {
+  typedef detail::StringBuffer<ARDUINOJSON_HANDLER_BUFFER_SIZE> string_buffer;
+
+ public:
+  JsonReader(TReader reader, DeserializationOption::NestingLimit nestingLimit)
+      : parser_(0, reader, string_buffer()),
+        nestingLimit_(nestingLimit),
+        state_(ExpectValue),
+        type_(JsonToken::None),
+        error_(DeserializationError::Ok) {}
+
+  // Moves to the next token.
+  // Returns false at the end of the input, or if an error occurred.
+  bool next() {
+    if (error_)
+      return false;
+
+    switch (state_) {
+      case ExpectValue:
+        return readValue();
+
+      case InArray:
+      case InObject:
+        // consume the bracket of the last ArrayStart or ObjectStart
+        parser_.move();
+        if (!skipSpaces())
+          return false;
+        if (parser_.eat(state_ == InObject ? '}' : ']'))
+          return closeCollection();
+        return state_ == InObject ? readKey() : readValue();
+
+      case AfterValue: {
+        if (stack_.empty())
+          return endRoot();
+        bool isObject = stack_.top().isObject;
+        if (!skipSpaces())
+          return false;
+        if (parser_.eat(isObject ? '}' : ']'))
+          return closeCollection();
+        if (!parser_.eat(','))
+          return fail(DeserializationError::InvalidInput);
+        return isObject ? readKey() : readValue();
+      }
+
+      default:
+        return end();
+    }
+  }
+
+  // Skips the value of the current token:
+  // - after ObjectStart or ArrayStart, skips the rest of the collection
+  // - after Key, skips the value of the member
+  // The next call to next() returns the token that follows.
+  bool skipValue() {
+    if (error_)
+      return false;
+
+    DeserializationError::Code err;
+
+    switch (state_) {
+      case InArray:
+      case InObject:
+        // the bracket hasn't been consumed yet, so we can skip the whole
+        // collection
+        popFrame();
+        err = parser_.skipVariant(nestingLimit_);
+        break;
+
+      case ExpectValue:
+        if (type_ != JsonToken::Key)
+          return true;
+        err = parser_.skipVariant(nestingLimit_);
+        break;
+
+      default:
+        return true;
+    }
+
+    if (err)
+      return fail(err);
+    state_ = AfterValue;
+    return true;
+  }
+
+  JsonToken::Type type() const {
+    return type_;
+  }
+
+  // Returns the number of collections that contain the current token,
+  // including the one that the current ObjectStart or ArrayStart opens.
+  size_t depth() const {
+    return stack_.size();
+  }
+
+  // Returns the key or the string.
+  // The string is only valid until the next call to next().
+  // Strings longer than ARDUINOJSON_HANDLER_BUFFER_SIZE - 1 fail with
+  // DeserializationError::StringTooLong.
+  JsonString getString() {
+    return parser_.stringStorage_.str();
+  }
+
+  int64_t getInt64() const {
+    return value_.asIntegral<int64_t>();
+  }
+
+  JsonFloat getFloat() const {
+    return value_.asFloat<JsonFloat>();
+  }
+
+  bool getBool() const {
+    return value_.asBoolean();
+  }
+
+  DeserializationError error() const {
+    return error_;
+  }
+
+ private:
+  enum State {
+    ExpectValue,
+    InArray,   // after ArrayStart
+    InObject,  // after ObjectStart
+    AfterValue,
+    Done,
+  };
+
+  struct Frame {
+    bool isObject;
+    DeserializationOption::NestingLimit nestingLimit;
+  };
+
+  bool readValue() {
+    if (!skipSpaces())
+      return false;
+
+    DeserializationError::Code err;
+
+    switch (parser_.current()) {
+      case '[':
+        return openCollection(false);
+
+      case '{':
+        return openCollection(true);
+
+      case '\"':
+      case '\'':
+        parser_.stringStorage_.startString();
+        err = parser_.parseQuotedString();
+        type_ = JsonToken::String;
+        break;
+
+      case 't':
+        value_.setBoolean(true);
+        err = parser_.skipKeyword("true");
+        type_ = JsonToken::Boolean;
+        break;
+
+      case 'f':
+        value_.setBoolean(false);
+        err = parser_.skipKeyword("false");
+        type_ = JsonToken::Boolean;
+        break;
+
+      case 'n':
+        value_.setNull();
+        err = parser_.skipKeyword("null");
+        type_ = JsonToken::Null;
+        break;
+
+      default:
+        err = parser_.parseNumericValue(value_);
+        type_ = value_.type() == detail::VALUE_IS_FLOAT ? JsonToken::Float
+                                                         : JsonToken::Integer;
+        break;
+    }
+
+    if (err)
+      return fail(err);
+    state_ = AfterValue;
+    return true;
+  }
+
+  bool readKey() {
+    DeserializationError::Code err;
+
+    if (!skipSpaces())
+      return false;
+
+    err = parser_.parseKey();
+    if (err)
+      return fail(err);
+
+    if (!skipSpaces())
+      return false;
+
+    if (!parser_.eat(':'))
+      return fail(DeserializationError::InvalidInput);
+
+    type_ = JsonToken::Key;
+    state_ = ExpectValue;
+    return true;
+  }
+
+  bool openCollection(bool isObject) {
+    Frame frame = {isObject, nestingLimit_};
+    if (nestingLimit_.reached())
+      return fail(DeserializationError::TooDeep);
+    if (!stack_.push(frame))
+      return fail(DeserializationError::NoMemory);
+    nestingLimit_ = nestingLimit_.decrement();
+    type_ = isObject ? JsonToken::ObjectStart : JsonToken::ArrayStart;
+    state_ = isObject ? InObject : InArray;
+    return true;
+  }
+
+  bool closeCollection() {
+    type_ = stack_.top().isObject ? JsonToken::ObjectEnd : JsonToken::ArrayEnd;
+    popFrame();
+    state_ = AfterValue;
+    return true;
+  }
+
+  void popFrame() {
+    nestingLimit_ = stack_.top().nestingLimit;
+    stack_.pop();
+  }
+
+  bool skipSpaces() {
+    DeserializationError::Code err = parser_.skipSpacesAndComments();
+    if (err)
+      return fail(err);
+    return true;
+  }
+
+  bool endRoot() {
+    bool enclosed = type_ == JsonToken::ArrayStart ||
+                    type_ == JsonToken::ArrayEnd ||
+                    type_ == JsonToken::ObjectStart ||
+                    type_ == JsonToken::ObjectEnd;
+    // We don't detect trailing characters earlier, so we need to check now
+    if (!enclosed && parser_.latch_.last() != 0)
+      return fail(DeserializationError::InvalidInput);
+    return end();
+  }
+
+  bool end() {
+    state_ = Done;
+    type_ = JsonToken::None;
+    return false;
+  }
+
+  bool fail(DeserializationError::Code err) {
+    error_ = detail::stringTooLongIfNoMemory(err);
+    type_ = JsonToken::None;
+    return false;
+  }
+
+  detail::JsonDeserializer<TReader, string_buffer> parser_;
+  DeserializationOption::NestingLimit nestingLimit_;
+  detail::ParseStack<Frame> stack_;
+  State state_;
+  JsonToken::Type type_;
+  DeserializationError::Code error_;
+  detail::VariantData value_;
+};
+
+// Creates a JsonReader for the specified input.
+template <typename TInput>
+JsonReader<detail::Reader<typename detail::remove_reference<TInput>::type>>
+makeJsonReader(TInput&& input, DeserializationOption::NestingLimit
+                                   nestingLimit = {}) {
+  return {detail::makeReader(detail::forward<TInput>(input)), nestingLimit};
+}
+
+// Creates a JsonReader for the specified input.
+template <typename TChar>
+JsonReader<detail::Reader<TChar*>> makeJsonReader(
+    TChar* input, DeserializationOption::NestingLimit nestingLimit = {}) {
+  return {detail::makeReader(input), nestingLimit};
+}
+
+// Creates a JsonReader for the specified input.
+template <typename TChar>
+JsonReader<detail::BoundedReader<TChar*>> makeJsonReader(
+    TChar* input, size_t inputSize,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  return {detail::makeReader(input, inputSize), nestingLimit};
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -78,6 +78,11 @@ class JsonSerializer : public Visitor<size_t> {
     return bytesWritten();
   }
 
+  // Writes the numbers kept by DeserializationOption::LazyNumbers unchanged
+  size_t visitRawNumber(const char* data, size_t n) {
+    return visitRawJson(data, n);
+  }
+
   size_t visitSignedInteger(JsonInteger value) {
     formatter_.writeInteger(value);
     return bytesWritten();
@@ -0,0 +1,500 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Deserialization/ParseStack.hpp>
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/JsonCharacters.hpp>
+#include <ArduinoJson/Json/StringScanner.hpp>
+#include <ArduinoJson/Json/Utf16.hpp>
+#include <ArduinoJson/Json/Utf8.hpp>
+#include <ArduinoJson/Numbers/parseNumber.hpp>
+#include <ArduinoJson/StringStorage/StringCopier.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Parses a JSON document that arrives in chunks, and puts the result in a
+// JsonDocument.
+// Unlike deserializeJson(), it never waits for the input: feed() consumes the
+// chunk and returns NeedMoreData if the document is not complete yet.
+// The document must not be modified until feed() returns Ok.
+class JsonStreamParser {
+ public:
+  JsonStreamParser(JsonDocument& doc,
+                   DeserializationOption::NestingLimit nestingLimit =
+                       DeserializationOption::NestingLimit())
+      : doc_(doc),
+        stringStorage_(detail::VariantAttorney::getPool(doc)),
+        maxNestingLimit_(nestingLimit) {
+    reset();
+  }
+
+  // Parses a chunk of input.
+  // Returns Ok once the document is complete, NeedMoreData if it needs another
+  // chunk, or an error.
+  // After the document, the parser only accepts spaces (and comments, if
+  // ARDUINOJSON_ENABLE_COMMENTS is 1), so feeding anything else fails with
+  // InvalidInput.
+  DeserializationError feed(const char* data, size_t size) {
+    const char* p = data;
+    const char* end = data + size;
+    if (error_ == DeserializationError::NeedMoreData ||
+        error_ == DeserializationError::Ok) {
+      while (p < end) {
+        error_ = step(p, end);
+        if (error_)
+          break;
+      }
+      if (!error_)
+        error_ = state_ == Done ? DeserializationError::Ok
+                                : DeserializationError::NeedMoreData;
+    }
+    consumed_ = size_t(p - data);
+    return error_;
+  }
+
+  // Tells that there is no more input.
+  // Returns Ok if the document is complete, or an error.
+  DeserializationError finish() {
+    if (error_ == DeserializationError::NeedMoreData) {
+      error_ = DeserializationError::Ok;
+      if (state_ == InNumber)  // a number at the root ends with the input
+        error_ = endNumber();
+#if ARDUINOJSON_ENABLE_COMMENTS
+      if (state_ == InLineComment)  // so does a line comment
+        state_ = stateBeforeComment_;
+#endif
+      if (error_ == DeserializationError::Ok && state_ != Done)
+        error_ = foundSomething_ ? DeserializationError::IncompleteInput
+                                 : DeserializationError::EmptyInput;
+    }
+    return error_;
+  }
+
+  // Returns the number of bytes of the last chunk that the parser consumed.
+  // After feed() returns an error, this is the position of the error.
+  size_t consumed() const {
+    return consumed_;
+  }
+
+  // Clears the document and prepares for a new one
+  void reset() {
+    doc_.clear();
+    target_ = detail::VariantAttorney::getData(doc_);
+    nestingLimit_ = maxNestingLimit_;
+    stack_.clear();
+    state_ = ExpectValue;
+    foundSomething_ = false;
+    consumed_ = 0;
+    error_ = DeserializationError::NeedMoreData;
+  }
+
+ private:
+  enum State {
+    ExpectValue,
+    ExpectValueOrClose,  // after '['
+    ExpectKey,
+    ExpectKeyOrClose,  // after '{'
+    ExpectColon,
+    ExpectCommaOrClose,
+    InString,
+    InEscape,
+    InHex,
+    InNonQuotedKey,
+    InNumber,
+    InKeyword,
+#if ARDUINOJSON_ENABLE_COMMENTS
+    InCommentStart,  // after '/'
+    InBlockComment,
+    InLineComment,
+#endif
+    Done,
+  };
+
+  struct Frame {
+    detail::CollectionData* collection;
+    bool isObject;
+    DeserializationOption::NestingLimit nestingLimit;
+  };
+
+  // Consumes one or more characters
+  DeserializationError::Code step(const char*& p, const char* end) {
+    char c = *p;
+
+    switch (state_) {
+      case ExpectValue:
+      case ExpectValueOrClose:
+      case ExpectKey:
+      case ExpectKeyOrClose:
+      case ExpectColon:
+      case ExpectCommaOrClose:
+      case Done:
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+          p++;
+          return DeserializationError::Ok;
+        }
+#if ARDUINOJSON_ENABLE_COMMENTS
+        if (c == '/') {
+          stateBeforeComment_ = state_;
+          state_ = InCommentStart;
+          p++;
+          return DeserializationError::Ok;
+        }
+#endif
+        foundSomething_ = true;
+        break;
+
+      default:
+        break;
+    }
+
+    switch (state_) {
+      case Done:  // a character after the document
+        return DeserializationError::InvalidInput;
+
+      case ExpectValueOrClose:
+        if (c == ']') {
+          p++;
+          return closeCollection();
+        }
+        state_ = ExpectValue;
+        return DeserializationError::Ok;
+
+      case ExpectValue:
+        return startValue(p);
+
+      case ExpectKeyOrClose:
+        if (c == '}') {
+          p++;
+          return closeCollection();
+        }
+        state_ = ExpectKey;
+        return DeserializationError::Ok;
+
+      case ExpectKey:
+        stringStorage_.startString();
+        isKey_ = true;
+        if (detail::isQuote(c)) {
+          startQuotedString(c);
+          p++;
+          return DeserializationError::Ok;
+        }
+        if (!detail::canBeInNonQuotedString(c))
+          return DeserializationError::InvalidInput;
+        state_ = InNonQuotedKey;
+        return DeserializationError::Ok;
+
+      case ExpectColon:
+        if (c != ':')
+          return DeserializationError::InvalidInput;
+        p++;
+        return addMember();
+
+      case ExpectCommaOrClose: {
+        const Frame& frame = stack_.top();
+        p++;
+        if (c == ',') {
+          state_ = frame.isObject ? ExpectKey : ExpectValue;
+          return DeserializationError::Ok;
+        }
+        if (c == (frame.isObject ? '}' : ']'))
+          return closeCollection();
+        return DeserializationError::InvalidInput;
+      }
+
+      case InString: {
+        // copy the plain characters in one call
+        const char* runEnd = detail::scanStringRun(p, end, quote_);
+        if (runEnd != p) {
+          stringStorage_.append(p, size_t(runEnd - p));
+          p = runEnd;
+          return DeserializationError::Ok;
+        }
+        p++;
+        if (c == quote_)
+          return endString();
+        if (c == '\\') {
+          state_ = InEscape;
+          return DeserializationError::Ok;
+        }
+        return DeserializationError::InvalidInput;  // '\0'
+      }
+
+      case InEscape:
+        state_ = InString;
+        if (c == 'u') {
+#if ARDUINOJSON_DECODE_UNICODE
+          p++;
+          hexValue_ = 0;
+          hexDigits_ = 0;
+          state_ = InHex;
+#else
+          stringStorage_.append('\\');
+#endif
+          return DeserializationError::Ok;
+        }
+        c = detail::EscapeSequence::unescapeChar(c);
+        if (c == '\0')
+          return DeserializationError::InvalidInput;
+        stringStorage_.append(c);
+        p++;
+        return DeserializationError::Ok;
+
+#if ARDUINOJSON_DECODE_UNICODE
+      case InHex: {
+        uint8_t value = detail::decodeHex(c);
+        if (value > 0x0F)
+          return DeserializationError::InvalidInput;
+        p++;
+        hexValue_ = uint16_t((hexValue_ << 4) | value);
+        if (++hexDigits_ < 4)
+          return DeserializationError::Ok;
+        if (codepoint_.append(hexValue_))
+          detail::Utf8::encodeCodepoint(codepoint_.value(), stringStorage_);
+        state_ = InString;
+        return DeserializationError::Ok;
+      }
+#endif
+
+      case InNonQuotedKey:
+        if (!detail::canBeInNonQuotedString(c)) {
+          state_ = ExpectColon;
+          return stringStorage_.isValid() ? DeserializationError::Ok
+                                          : DeserializationError::NoMemory;
+        }
+        stringStorage_.append(c);
+        p++;
+        return DeserializationError::Ok;
+
+      case InNumber:
+        if (!detail::canBeInNumber(c))
+          return endNumber();
+        appendToNumber(c);
+        p++;
+        return DeserializationError::Ok;
+
+      case InKeyword:
+        if (c != *keyword_)
+          return DeserializationError::InvalidInput;
+        p++;
+        if (*++keyword_)
+          return DeserializationError::Ok;
+        return endValue();
+
+#if ARDUINOJSON_ENABLE_COMMENTS
+      case InCommentStart:
+        p++;
+        if (c == '*')
+          state_ = InBlockComment;
+        else if (c == '/')
+          state_ = InLineComment;
+        else
+          return DeserializationError::InvalidInput;
+        wasStar_ = false;
+        return DeserializationError::Ok;
+
+      case InBlockComment:
+        p++;
+        if (c == '/' && wasStar_)
+          state_ = stateBeforeComment_;
+        wasStar_ = c == '*';
+        return DeserializationError::Ok;
+
+      case InLineComment:
+        p++;
+        if (c == '\n')
+          state_ = stateBeforeComment_;
+        return DeserializationError::Ok;
+#endif
+
+      default:
+        ARDUINOJSON_ASSERT(false);
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  DeserializationError::Code startValue(const char*& p) {
+    if (!stack_.empty() && !stack_.top().isObject) {
+      target_ = stack_.top().collection->addElement(pool());
+      if (!target_)
+        return DeserializationError::NoMemory;
+    }
+
+    char c = *p;
+    switch (c) {
+      case '[':
+        p++;
+        state_ = ExpectValueOrClose;
+        return openCollection(target_->toArray(), false);
+
+      case '{':
+        p++;
+        state_ = ExpectKeyOrClose;
+        return openCollection(target_->toObject(), true);
+
+      case '\"':
+      case '\'':
+        p++;
+        stringStorage_.startString();
+        isKey_ = false;
+        startQuotedString(c);
+        return DeserializationError::Ok;
+
+      case 't':
+        target_->setBoolean(true);
+        return startKeyword(p, "true");
+
+      case 'f':
+        target_->setBoolean(false);
+        return startKeyword(p, "false");
+
+      case 'n':
+        // the variant should already by null, except if the same object key was
+        // used twice, as in {"a":1,"a":null}
+        return startKeyword(p, "null");
+
+      default:
+        if (!detail::canBeInNumber(c))
+          return DeserializationError::InvalidInput;
+        numberLength_ = 0;
+        state_ = InNumber;
+        return DeserializationError::Ok;
+    }
+  }
+
+  DeserializationError::Code startKeyword(const char*& p, const char* keyword) {
+    p++;
+    keyword_ = keyword + 1;
+    state_ = InKeyword;
+    return DeserializationError::Ok;
+  }
+
+  void startQuotedString(char quote) {
+    quote_ = quote;
+#if ARDUINOJSON_DECODE_UNICODE
+    codepoint_ = detail::Utf16::Codepoint();
+#endif
+    state_ = InString;
+  }
+
+  DeserializationError::Code endString() {
+    if (!stringStorage_.isValid())
+      return DeserializationError::NoMemory;
+    if (isKey_) {
+      state_ = ExpectColon;
+      return DeserializationError::Ok;
+    }
+    target_->setString(stringStorage_.save());
+    return endValue();
+  }
+
+  // Short numbers stay in number_; longer ones move to the free zone of the
+  // memory pool, like strings, but they are never saved.
+  void appendToNumber(char c) {
+    if (numberLength_ < sizeof(number_) - 1) {
+      number_[numberLength_++] = c;
+      return;
+    }
+    if (numberLength_ == sizeof(number_) - 1) {
+      stringStorage_.startString();
+      stringStorage_.append(number_, numberLength_);
+      numberLength_++;
+    }
+    stringStorage_.append(c);
+  }
+
+  DeserializationError::Code endNumber() {
+    // not the overload that takes a latch
+    const char* number = number_;
+    if (numberLength_ < sizeof(number_)) {
+      number_[numberLength_] = 0;
+    } else {
+      if (!stringStorage_.isValid())
+        return DeserializationError::NoMemory;
+      number = stringStorage_.str().c_str();
+    }
+    if (!detail::parseNumber(number, *target_))
+      return DeserializationError::InvalidInput;
+    return endValue();
+  }
+
+  DeserializationError::Code addMember() {
+    detail::CollectionData* object = stack_.top().collection;
+    JsonString key = stringStorage_.str();
+    target_ = object->getMember(detail::adaptString(key.c_str()));
+    if (!target_) {
+      // Save key in memory pool.
+      // This MUST be done before adding the slot.
+      key = stringStorage_.save();
+
+      detail::VariantSlot* slot = object->addSlot(pool());
+      if (!slot)
+        return DeserializationError::NoMemory;
+
+      slot->setKey(key);
+      target_ = slot->data();
+    }
+    state_ = ExpectValue;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code openCollection(
+      detail::CollectionData& collection, bool isObject) {
+    Frame frame = {&collection, isObject, nestingLimit_};
+    if (nestingLimit_.reached())
+      return DeserializationError::TooDeep;
+    if (!stack_.push(frame))
+      return DeserializationError::NoMemory;
+    nestingLimit_ = nestingLimit_.decrement();
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code closeCollection() {
+    nestingLimit_ = stack_.top().nestingLimit;
+    stack_.pop();
+    return endValue();
+  }
+
+  DeserializationError::Code endValue() {
+    state_ = stack_.empty() ? Done : ExpectCommaOrClose;
+    return DeserializationError::Ok;
+  }
+
+  detail::MemoryPool* pool() {
+    return detail::VariantAttorney::getPool(doc_);
+  }
+
+  JsonDocument& doc_;
+  detail::StringCopier stringStorage_;
+  DeserializationOption::NestingLimit maxNestingLimit_;
+  DeserializationOption::NestingLimit nestingLimit_;
+  detail::ParseStack<Frame> stack_;
+  State state_;
+  DeserializationError::Code error_;
+  size_t consumed_;
+  bool foundSomething_;
+  detail::VariantData* target_;
+
+  // state of the current token
+  bool isKey_;
+  char quote_;
+  const char* keyword_;
+  char number_[32];
+  uint8_t numberLength_;  // sizeof(number_) once in the pool
+#if ARDUINOJSON_DECODE_UNICODE
+  detail::Utf16::Codepoint codepoint_;
+  uint16_t hexValue_;
+  uint8_t hexDigits_;
+#endif
+#if ARDUINOJSON_ENABLE_COMMENTS
+  State stateBeforeComment_;
+  bool wasStar_;
+#endif
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
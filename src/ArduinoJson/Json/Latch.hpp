@@ -4,14 +4,15 @@
 
 #pragma once
 
+#include <ArduinoJson/Deserialization/Reader.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
-template <typename TReader>
+template <typename TReader, typename Enable = void>
 class Latch {
  public:
-  Latch(TReader reader) : reader_(reader), loaded_(false) {
+  Latch(TReader reader) : reader_(reader), loaded_(false), position_(0) {
 #if ARDUINOJSON_DEBUG
     ended_ = false;
 #endif
@@ -32,6 +33,22 @@ class Latch {
     return current_;
   }
 
+  // Returns the number of characters consumed so far
+  size_t position() const {
+    return loaded_ && current_ ? position_ - 1 : position_;
+  }
+
+  // The input is not contiguous, so there is nothing to scan
+  const char* begin() const {
+    return 0;
+  }
+
+  const char* end() const {
+    return 0;
+  }
+
+  void seek(const char*) {}
+
  private:
   void load() {
     ARDUINOJSON_ASSERT(!ended_);
@@ -41,6 +58,8 @@ class Latch {
       ended_ = true;
 #endif
     current_ = static_cast<char>(c > 0 ? c : 0);
+    if (current_)
+      position_++;
     loaded_ = true;
   }
 
@@ -48,9 +67,59 @@ class Latch {
   char current_;  // NOLINT(clang-analyzer-optin.cplusplus.UninitializedObject)
                   // Not initialized in constructor (+10 bytes on AVR)
   bool loaded_;
+  size_t position_;
 #if ARDUINOJSON_DEBUG
   bool ended_;
 #endif
 };
 
+// When the input is a contiguous buffer in RAM, the latch is just a cursor:
+// it reads the buffer directly instead of calling read() for each byte.
+// Like the reader, it returns 0 after the end of the input.
+template <typename TReader>
+class Latch<TReader,
+            typename enable_if<IsContiguousReader<TReader>::value>::type> {
+ public:
+  Latch(TReader reader)
+      : begin_(reader.begin()), ptr_(reader.begin()), end_(reader.end()) {}
+
+  void clear() {
+    if (ptr_ < end_)
+      ptr_++;
+  }
+
+  int last() const {
+    return ptr_ < end_ ? *ptr_ : 0;
+  }
+
+  FORCE_INLINE char current() {
+    return ptr_ < end_ ? *ptr_ : 0;
+  }
+
+  // Returns the number of characters consumed so far
+  size_t position() const {
+    return size_t(ptr_ - begin_);
+  }
+
+  // Returns the part of the input that hasn't been consumed
+  const char* begin() const {
+    return ptr_;
+  }
+
+  const char* end() const {
+    return end_;
+  }
+
+  // Consumes the input up to p
+  void seek(const char* p) {
+    ARDUINOJSON_ASSERT(ptr_ <= p && p <= end_);
+    ptr_ = p;
+  }
+
+ private:
+  const char* begin_;
+  const char* ptr_;
+  const char* end_;
+};
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,572 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+#include <ArduinoJson/StringStorage/StringBuffer.hpp>
+
+#include <string.h>  // strlen
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Tells if the result of as<T>() can point to the memory pool
+template <typename T>
+struct RefersToPool
+    : integral_constant<bool, is_pointer<T>::value ||
+                                  is_same<T, JsonString>::value ||
+                                  is_same<T, JsonVariantConst>::value ||
+                                  is_same<T, JsonArrayConst>::value ||
+                                  is_same<T, JsonObjectConst>::value> {};
+
+// The members and the materialized values that a LazyJsonDocument remembers.
+// A value is identified by its position in the input.
+class LazyIndex {
+ public:
+  struct Entry {
+    const char* object;  // the object that contains the member, or null
+    const char* key;     // the position of the member's key in the input
+    const char* begin;
+    const char* end;
+    VariantData* data;  // the materialized value, or null
+  };
+
+  LazyIndex() : size_(0), next_(0) {}
+
+  size_t size() const {
+    return size_;
+  }
+
+  const Entry& operator[](size_t i) const {
+    ARDUINOJSON_ASSERT(i < size_);
+    return entries_[i];
+  }
+
+  void addMember(const char* object, const char* key, const char* begin,
+                 const char* end) {
+    Entry* entry = allocEntry();
+    if (!entry)
+      return;
+    Entry e = {object, key, begin, end, 0};
+    *entry = e;
+  }
+
+  VariantData* findData(const char* begin) const {
+    for (size_t i = 0; i < size_; i++) {
+      if (entries_[i].begin == begin && entries_[i].data)
+        return entries_[i].data;
+    }
+    return 0;
+  }
+
+  // Returns false if the index is full of materialized values
+  bool addData(const char* begin, const char* end, VariantData* data) {
+    for (size_t i = 0; i < size_; i++) {
+      if (entries_[i].begin == begin) {
+        entries_[i].data = data;
+        return true;
+      }
+    }
+    Entry* entry = allocEntry();
+    if (!entry)
+      return false;
+    Entry e = {0, 0, begin, end, data};
+    *entry = e;
+    return true;
+  }
+
+  void clear() {
+    size_ = 0;
+    next_ = 0;
+  }
+
+ private:
+  // Once full, replaces the members in turn; the materialized values stay,
+  // so they are not parsed twice
+  Entry* allocEntry() {
+    if (size_ < ARDUINOJSON_LAZY_INDEX_SIZE)
+      return &entries_[size_++];
+    for (size_t i = 0; i < size_; i++) {
+      Entry* entry = &entries_[next_];
+      next_ = (next_ + 1) % ARDUINOJSON_LAZY_INDEX_SIZE;
+      if (!entry->data)
+        return entry;
+    }
+    return 0;
+  }
+
+  Entry entries_[ARDUINOJSON_LAZY_INDEX_SIZE];
+  size_t size_;
+  size_t next_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+class LazyJsonIterator;
+
+// A reference to a value in a JSON buffer that hasn't been parsed yet.
+// Looking up a member or an element only scans the input: the siblings are
+// skipped, and nothing is allocated.
+// The value is parsed when you call materialize() or as<T>().
+class LazyJsonValue {
+  friend class LazyJsonIterator;
+
+ public:
+  LazyJsonValue()
+      : storage_(0),
+        index_(0),
+        begin_(0),
+        end_(0),
+        error_(DeserializationError::Ok) {}
+
+  LazyJsonValue(JsonDocument* storage, const char* begin, const char* end,
+                DeserializationOption::NestingLimit nestingLimit,
+                detail::LazyIndex* index = 0)
+      : storage_(storage),
+        index_(index),
+        begin_(begin),
+        end_(end),
+        nestingLimit_(nestingLimit),
+        error_(DeserializationError::Ok) {}
+
+  // Gets the array's element at specified index.
+  // Returns an unbound value if the index is out of range.
+  LazyJsonValue operator[](size_t index) const;
+
+  // Gets the object's member with specified key.
+  // Returns an unbound value if the key is missing.
+  // When the key is present several times, the first member is returned.
+  template <typename TString>
+  typename detail::enable_if<detail::IsString<TString>::value,
+                             LazyJsonValue>::type
+  operator[](const TString& key) const {
+    return getMember(detail::adaptString(key));
+  }
+
+  // Gets the object's member with specified key.
+  // Returns an unbound value if the key is missing.
+  // When the key is present several times, the first member is returned.
+  template <typename TChar>
+  typename detail::enable_if<detail::IsString<TChar*>::value,
+                             LazyJsonValue>::type
+  operator[](TChar* key) const {
+    return getMember(detail::adaptString(key));
+  }
+
+  // Returns an iterator to the first element or member.
+  LazyJsonIterator begin() const;
+
+  // Returns an iterator following the last element or member.
+  LazyJsonIterator end() const;
+
+  // Parses the value and puts the result in the storage document.
+  // The LazyJsonDocument remembers ARDUINOJSON_LAZY_INDEX_SIZE materialized
+  // values, so calling it again returns the same copy; past this number,
+  // each call allocates a new copy in the pool.
+  // Returns null if the value is unbound or if the parsing failed.
+  JsonVariantConst materialize() const;
+
+  // Parses the value and converts it to the specified type.
+  // Unless the result points to the storage document (like a const char*),
+  // the memory used for the parsing is released, so calling it again doesn't
+  // use more memory. A materialized value is converted without parsing.
+  template <typename T>
+  typename detail::enable_if<!detail::RefersToPool<T>::value, T>::type as()
+      const;
+
+  // Parses the value and converts it to the specified type.
+  // The result points to the copy of the value in the storage document.
+  template <typename T>
+  typename detail::enable_if<detail::RefersToPool<T>::value, T>::type as()
+      const {
+    return materialize().as<T>();
+  }
+
+  // Returns true if the value wasn't found in the input.
+  bool isUnbound() const {
+    return begin_ == 0;
+  }
+
+  // Returns the error that occurred while looking for the value.
+  DeserializationError error() const {
+    return error_;
+  }
+
+ private:
+  template <typename TAdaptedString>
+  LazyJsonValue getMember(TAdaptedString key) const;
+
+  template <typename TAdaptedString>
+  bool keyEquals(const char* position, TAdaptedString key) const;
+
+  bool parse(detail::VariantData& data, detail::MemoryPool* pool) const;
+
+  static LazyJsonValue failed(DeserializationError::Code err) {
+    LazyJsonValue result;
+    result.error_ = err;
+    return result;
+  }
+
+  JsonDocument* storage_;
+  detail::LazyIndex* index_;
+  const char* begin_;
+  const char* end_;
+  DeserializationOption::NestingLimit nestingLimit_;
+  DeserializationError::Code error_;
+};
+
+// Iterates over the elements of an array or the members of an object of a
+// LazyJsonValue, skipping the values instead of parsing them.
+class LazyJsonIterator {
+  friend class LazyJsonValue;
+
+  typedef detail::BoundedReader<const char*> reader_type;
+  typedef detail::StringBuffer<ARDUINOJSON_HANDLER_BUFFER_SIZE> string_buffer;
+
+ public:
+  // Creates an iterator that points after the last element.
+  LazyJsonIterator()
+      : parser_(0, reader_type(0, 0), string_buffer()),
+        storage_(0),
+        index_(0),
+        key_(0),
+        isObject_(false),
+        done_(true),
+        first_(true) {}
+
+  LazyJsonIterator(const LazyJsonValue& collection)
+      : parser_(0,
+                reader_type(collection.begin_,
+                            size_t(collection.end_ - collection.begin_)),
+                string_buffer()),
+        storage_(collection.storage_),
+        index_(collection.index_),
+        key_(0),
+        nestingLimit_(collection.nestingLimit_),
+        isObject_(false),
+        done_(true),
+        first_(true) {
+    if (collection.isUnbound()) {
+      value_ = collection;  // keep the error, if any
+      return;
+    }
+    if (!skipSpaces())
+      return;
+    char c = parser_.current();
+    if (c != '[' && c != '{')
+      return;
+    if (nestingLimit_.reached()) {
+      fail(DeserializationError::TooDeep);
+      return;
+    }
+    isObject_ = c == '{';
+    nestingLimit_ = nestingLimit_.decrement();
+    parser_.move();
+    done_ = false;
+    next();
+  }
+
+  LazyJsonValue operator*() const {
+    return value_;
+  }
+
+  const LazyJsonValue* operator->() const {
+    return &value_;
+  }
+
+  // Returns the key of the current member.
+  // The string is only valid until the iterator moves.
+  // Keys longer than ARDUINOJSON_HANDLER_BUFFER_SIZE - 1 stop the iteration
+  // with DeserializationError::StringTooLong.
+  JsonString key() {
+    return isObject_ ? parser_.stringStorage_.str() : JsonString();
+  }
+
+  LazyJsonIterator& operator++() {
+    next();
+    return *this;
+  }
+
+  bool operator==(const LazyJsonIterator& other) const {
+    if (done_ || other.done_)
+      return done_ == other.done_;
+    return value_.begin_ == other.value_.begin_;
+  }
+
+  bool operator!=(const LazyJsonIterator& other) const {
+    return !operator==(other);
+  }
+
+  // Returns the error that stopped the iteration, if any.
+  DeserializationError error() const {
+    return value_.error_;
+  }
+
+ private:
+  void next() {
+    if (done_)
+      return;
+
+    if (!skipSpaces())
+      return;
+
+    // More elements?
+    if (parser_.eat(isObject_ ? '}' : ']')) {
+      done_ = true;
+      return;
+    }
+    if (!first_ && !parser_.eat(','))
+      return fail(DeserializationError::InvalidInput);
+    first_ = false;
+
+    DeserializationError::Code err;
+
+    if (isObject_) {
+      if (!skipSpaces())
+        return;
+
+      key_ = parser_.latch_.begin();
+      err = parser_.parseKey();
+      if (err)
+        return fail(detail::stringTooLongIfNoMemory(err));
+
+      if (!skipSpaces())
+        return;
+
+      if (!parser_.eat(':'))
+        return fail(DeserializationError::InvalidInput);
+    }
+
+    if (!skipSpaces())
+      return;
+
+    const char* begin = parser_.latch_.begin();
+    err = parser_.skipVariant(nestingLimit_);
+    if (err)
+      return fail(err);
+
+    // skipVariant() accepts an empty number, as in [1,]
+    if (parser_.latch_.begin() == begin)
+      return fail(DeserializationError::InvalidInput);
+
+    value_ = LazyJsonValue(storage_, begin, parser_.latch_.begin(),
+                           nestingLimit_, index_);
+  }
+
+  bool skipSpaces() {
+    DeserializationError::Code err = parser_.skipSpacesAndComments();
+    if (err) {
+      fail(err);
+      return false;
+    }
+    return true;
+  }
+
+  void fail(DeserializationError::Code err) {
+    value_ = LazyJsonValue::failed(err);
+    done_ = true;
+  }
+
+  detail::JsonDeserializer<reader_type, string_buffer> parser_;
+  JsonDocument* storage_;
+  detail::LazyIndex* index_;
+  const char* key_;  // the position of the current key in the input
+  DeserializationOption::NestingLimit nestingLimit_;
+  LazyJsonValue value_;
+  bool isObject_;
+  bool done_;
+  bool first_;
+};
+
+inline LazyJsonValue LazyJsonValue::operator[](size_t index) const {
+  LazyJsonIterator it(*this), end;
+  for (; it != end; ++it) {
+    if (index-- == 0)
+      return *it;
+  }
+  return it.error() ? failed(it.error().code()) : LazyJsonValue();
+}
+
+template <typename TAdaptedString>
+inline LazyJsonValue LazyJsonValue::getMember(TAdaptedString key) const {
+  if (key.isNull())
+    return LazyJsonValue();
+
+  // A member that was already found?
+  if (index_ && !isUnbound()) {
+    for (size_t i = 0; i < index_->size(); i++) {
+      const detail::LazyIndex::Entry& entry = (*index_)[i];
+      if (entry.object == begin_ && keyEquals(entry.key, key))
+        return LazyJsonValue(storage_, entry.begin, entry.end,
+                             nestingLimit_.decrement(), index_);
+    }
+  }
+
+  LazyJsonIterator it(*this), end;
+  for (; it != end; ++it) {
+    JsonString k = it.key();
+    if (!k.isNull() && stringEquals(key, detail::adaptString(k))) {
+      if (index_)
+        index_->addMember(begin_, it.key_, it->begin_, it->end_);
+      return *it;
+    }
+  }
+  return it.error() ? failed(it.error().code()) : LazyJsonValue();
+}
+
+template <typename TAdaptedString>
+inline bool LazyJsonValue::keyEquals(const char* position,
+                                     TAdaptedString key) const {
+  using namespace detail;
+
+  JsonDeserializer<LazyJsonIterator::reader_type,
+                   LazyJsonIterator::string_buffer>
+      parser(0,
+             LazyJsonIterator::reader_type(position, size_t(end_ - position)),
+             LazyJsonIterator::string_buffer());
+  if (parser.parseKey())
+    return false;
+  return stringEquals(key, adaptString(parser.stringStorage_.str()));
+}
+
+inline LazyJsonIterator LazyJsonValue::begin() const {
+  return LazyJsonIterator(*this);
+}
+
+inline LazyJsonIterator LazyJsonValue::end() const {
+  return LazyJsonIterator();
+}
+
+inline JsonVariantConst LazyJsonValue::materialize() const {
+  using namespace detail;
+
+  if (isUnbound() || !storage_)
+    return JsonVariantConst();
+
+  VariantData* data = index_ ? index_->findData(begin_) : 0;
+  if (data)
+    return JsonVariantConst(data);
+
+  MemoryPool* pool = VariantAttorney::getPool(*storage_);
+  data = VariantAttorney::getData(*storage_)->addElement(pool);
+  if (!data)
+    return JsonVariantConst();
+
+  // a value that fails to parse stays null, so it isn't parsed again
+  if (!parse(*data, pool))
+    data->setNull();
+
+  if (index_)
+    index_->addData(begin_, end_, data);
+
+  return JsonVariantConst(data);
+}
+
+template <typename T>
+inline typename detail::enable_if<!detail::RefersToPool<T>::value, T>::type
+LazyJsonValue::as() const {
+  using namespace detail;
+
+  if (isUnbound() || !storage_)
+    return JsonVariantConst().as<T>();
+
+  const VariantData* materialized = index_ ? index_->findData(begin_) : 0;
+  if (materialized)
+    return JsonVariantConst(materialized).as<T>();
+
+  // The parsing can't reuse released slots, or the rollback would lose them
+  MemoryPool* pool = VariantAttorney::getPool(*storage_);
+  MemoryPool::Checkpoint checkpoint = pool->checkpoint();
+  pool->setReleasedVariantsAside();
+
+  VariantData data;
+  bool parsed = parse(data, pool);
+  T result = parsed ? JsonVariantConst(&data).as<T>()
+                    : JsonVariantConst().as<T>();
+  pool->rollback(checkpoint);
+
+  // the free zone is too small, but the released slots may be enough
+  if (!parsed && checkpoint.freeVariants)
+    return materialize().as<T>();
+  return result;
+}
+
+inline bool LazyJsonValue::parse(detail::VariantData& data,
+                                 detail::MemoryPool* pool) const {
+  using namespace detail;
+
+  JsonDeserializer<BoundedReader<const char*>, StringCopier> parser(
+      pool, BoundedReader<const char*>(begin_, size_t(end_ - begin_)),
+      StringCopier(pool));
+  return !parser.parseVariant(data, AllowAllFilter(), nestingLimit_);
+}
+
+// A JSON document that is parsed on demand.
+// It keeps a pointer to the input, so the input must outlive the document.
+// Only the values that you materialize are stored in the JsonDocument passed
+// to the constructor; the rest of the input is only scanned.
+// The values refer to the document, which remembers the members they found
+// and the values they materialized, so the document must outlive them, and
+// the storage document must not be cleared in the meantime.
+class LazyJsonDocument {
+ public:
+  LazyJsonDocument(JsonDocument& storage, const char* input,
+                   DeserializationOption::NestingLimit nestingLimit = {})
+      : root_(&storage, input, input ? input + strlen(input) : input,
+              nestingLimit, &index_) {
+    storage.clear();
+  }
+
+  LazyJsonDocument(JsonDocument& storage, const char* input, size_t inputSize,
+                   DeserializationOption::NestingLimit nestingLimit = {})
+      : root_(&storage, input, input + inputSize, nestingLimit, &index_) {
+    storage.clear();
+  }
+
+  // Returns the root value of the document.
+  LazyJsonValue root() const {
+    return root_;
+  }
+
+  // Gets the root array's element at specified index.
+  LazyJsonValue operator[](size_t index) const {
+    return root_[index];
+  }
+
+  // Gets the root object's member with specified key.
+  template <typename TString>
+  typename detail::enable_if<detail::IsString<TString>::value,
+                             LazyJsonValue>::type
+  operator[](const TString& key) const {
+    return root_[key];
+  }
+
+  // Gets the root object's member with specified key.
+  template <typename TChar>
+  typename detail::enable_if<detail::IsString<TChar*>::value,
+                             LazyJsonValue>::type
+  operator[](TChar* key) const {
+    return root_[key];
+  }
+
+  LazyJsonIterator begin() const {
+    return root_.begin();
+  }
+
+  LazyJsonIterator end() const {
+    return root_.end();
+  }
+
+ private:
+  LazyJsonDocument(const LazyJsonDocument&);
+  LazyJsonDocument& operator=(const LazyJsonDocument&);
+
+  LazyJsonValue root_;
+  detail::LazyIndex index_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,65 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// These functions test several characters at once by loading them in a
+// machine word (SWAR = SIMD within a register).
+// They only tell if a word contains a byte, so callers must find the exact
+// position with a regular loop.
+
+// Returns a word with all bytes set to c
+inline size_t swarRepeat(char c) {
+  return size_t(-1) / 0xFF * static_cast<unsigned char>(c);
+}
+
+// Returns non-zero if one of the bytes is zero
+inline size_t swarHasZero(size_t word) {
+  const size_t ones = size_t(-1) / 0xFF;
+  return (word - ones) & ~word & (ones << 7);
+}
+
+// Returns non-zero if one of the bytes is equal to c
+inline size_t swarHasByte(size_t word, size_t repeatedChar) {
+  return swarHasZero(word ^ repeatedChar);
+}
+
+inline size_t swarLoad(const char* p) {
+  size_t word;
+  memcpy(&word, p, sizeof(word));  // unaligned load
+  return word;
+}
+
+inline bool isEndOfStringRun(char c, char stopChar) {
+  return c == stopChar || c == '\\' || c == '\0';
+}
+
+// Returns a pointer to the first character in [p, end) that interrupts a run
+// of plain characters in a string: the closing quote, a backslash, or a null.
+inline const char* scanStringRun(const char* p, const char* end,
+                                 char stopChar) {
+  if (sizeof(size_t) >= 4) {
+    const size_t quotes = swarRepeat(stopChar);
+    const size_t backslashes = swarRepeat('\\');
+    while (size_t(end - p) >= sizeof(size_t)) {
+      size_t word = swarLoad(p);
+      if (swarHasZero(word) | swarHasByte(word, quotes) |
+          swarHasByte(word, backslashes))
+        break;
+      p += sizeof(size_t);
+    }
+  }
+  while (p < end && !isEndOfStringRun(*p, stopChar))
+    p++;
+  return p;
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -8,6 +8,7 @@
 #include <string.h>  // for strlen
 
 #include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/Utf8.hpp>
 #include <ArduinoJson/Numbers/FloatParts.hpp>
 #include <ArduinoJson/Numbers/JsonInteger.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
@@ -38,17 +39,39 @@ class TextFormatter {
 
   void writeString(const char* value) {
     ARDUINOJSON_ASSERT(value != NULL);
+#if ARDUINOJSON_REPLACE_INVALID_UTF8
+    writeString(value, strlen(value));
+#else
     writeRaw('\"');
     while (*value)
       writeChar(*value++);
     writeRaw('\"');
+#endif
   }
 
   void writeString(const char* value, size_t n) {
     ARDUINOJSON_ASSERT(value != NULL);
     writeRaw('\"');
+#if ARDUINOJSON_REPLACE_INVALID_UTF8
+    const char* end = value + n;
+    while (value < end) {
+      if (static_cast<unsigned char>(*value) < 0x80) {
+        writeChar(*value++);
+        continue;
+      }
+      size_t len = Utf8::validCharLength(value, end);
+      if (len) {
+        writeRaw(value, value + len);
+        value += len;
+      } else {
+        writeRaw("\\ufffd");  // one replacement character per invalid byte
+        value++;
+      }
+    }
+#else
     while (n--)
       writeChar(*value++);
+#endif
     writeRaw('\"');
   }
 
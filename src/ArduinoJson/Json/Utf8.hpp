@@ -4,7 +4,9 @@
 
 #pragma once
 
-#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Json/StringScanner.hpp>
+
+#include <stdint.h>  // uint8_t
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
@@ -42,5 +44,88 @@ inline void encodeCodepoint(uint32_t codepoint32, TStringBuilder& str) {
     }
   }
 }
+
+// Checks that a sequence of bytes is well-formed UTF-8, as defined by
+// RFC 3629: no overlong encodings, no surrogates, nothing above U+10FFFF.
+// The bytes can be fed one at a time, so the input doesn't need to be
+// contiguous.
+class Validator {
+ public:
+  Validator() : remaining_(0), min_(0x80), max_(0xBF) {}
+
+  // Returns false if the byte makes the sequence invalid
+  bool append(char c) {
+    uint8_t b = static_cast<uint8_t>(c);
+    if (remaining_) {
+      if (b < min_ || b > max_)
+        return false;
+      min_ = 0x80;
+      max_ = 0xBF;
+      remaining_--;
+      return true;
+    }
+    if (b < 0x80)
+      return true;
+    if (b < 0xC2)  // continuation byte or overlong 2-byte sequence
+      return false;
+    if (b < 0xE0) {
+      remaining_ = 1;
+    } else if (b < 0xF0) {
+      remaining_ = 2;
+      if (b == 0xE0)  // overlong
+        min_ = 0xA0;
+      else if (b == 0xED)  // surrogate
+        max_ = 0x9F;
+    } else if (b < 0xF5) {
+      remaining_ = 3;
+      if (b == 0xF0)  // overlong
+        min_ = 0x90;
+      else if (b == 0xF4)  // above U+10FFFF
+        max_ = 0x8F;
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  // Returns false if the bytes make the sequence invalid.
+  // Skips ASCII characters a word at a time.
+  bool append(const char* begin, const char* end) {
+    const size_t highBits = swarRepeat(char(0x80));
+    while (begin < end) {
+      if (!remaining_) {
+        while (size_t(end - begin) >= sizeof(size_t) &&
+               !(swarLoad(begin) & highBits))
+          begin += sizeof(size_t);
+        if (begin == end)
+          break;
+      }
+      if (!append(*begin++))
+        return false;
+    }
+    return true;
+  }
+
+  // Returns false if the sequence ends in the middle of a character
+  bool complete() const {
+    return remaining_ == 0;
+  }
+
+ private:
+  uint8_t remaining_;  // number of continuation bytes expected
+  uint8_t min_, max_;  // range of the next continuation byte
+};
+
+// Returns the length of the character at the beginning of [s, end), or 0 if
+// it's not well-formed UTF-8.
+inline size_t validCharLength(const char* s, const char* end) {
+  Validator validator;
+  const char* p = s;
+  do {
+    if (p == end || !validator.append(*p++))
+      return 0;
+  } while (!validator.complete());
+  return size_t(p - s);
+}
 }  // namespace Utf8
 ARDUINOJSON_END_PRIVATE_NAMESPACE
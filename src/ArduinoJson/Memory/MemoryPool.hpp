@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Memory/Alignment.hpp>
+#include <ArduinoJson/Memory/StringIndex.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/mpl/max.hpp>
 #include <ArduinoJson/Strings/StringAdapters.hpp>
@@ -41,6 +42,7 @@ class MemoryPool {
         left_(buf),
         right_(buf ? buf + capa : 0),
         end_(buf ? buf + capa : 0),
+        freeVariants_(0),
         overflowed_(false) {
     ARDUINOJSON_ASSERT(isAligned(begin_));
     ARDUINOJSON_ASSERT(isAligned(right_));
@@ -65,17 +67,37 @@ class MemoryPool {
     return overflowed_;
   }
 
+  // Reuses a released slot, or allocates a new one
   VariantSlot* allocVariant() {
+    if (freeVariants_) {
+      void* slot = end_ - freeVariants_;
+      memcpy(&freeVariants_, slot, sizeof(freeVariants_));
+      return reinterpret_cast<VariantSlot*>(slot);
+    }
     return allocRight<VariantSlot>();
   }
 
+  // Gives a slot back, so allocVariant() can reuse it.
+  // The released slots form a list; each one stores the position of the
+  // next one as a distance from the end of the pool, so the list remains
+  // valid when the pool moves.
+  void freeVariant(VariantSlot* slot) {
+    static_assert(sizeof(VariantSlot) >= sizeof(size_t),
+                  "A released slot must be able to hold a position");
+    if (!owns(slot))
+      return;
+    memcpy(static_cast<void*>(slot), &freeVariants_, sizeof(freeVariants_));
+    freeVariants_ = size_t(end_ - reinterpret_cast<char*>(slot));
+  }
+
   template <typename TAdaptedString>
   const char* saveString(TAdaptedString str) {
     if (str.isNull())
       return 0;
 
 #if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
-    const char* existingCopy = findString(str);
+    uint32_t hash = hashString(str);
+    const char* existingCopy = findString(str, hash);
     if (existingCopy)
       return existingCopy;
 #endif
@@ -86,6 +108,9 @@ class MemoryPool {
     if (newCopy) {
       stringGetChars(str, newCopy, n);
       newCopy[n] = 0;  // force null-terminator
+#if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+      indexString(newCopy, hash);
+#endif
     }
     return newCopy;
   }
@@ -97,18 +122,50 @@ class MemoryPool {
 
   const char* saveStringFromFreeZone(size_t len) {
 #if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
-    const char* dup = findString(adaptString(left_, len));
+    uint32_t hash = hashString(adaptString(left_, len));
+    const char* dup = findString(adaptString(left_, len), hash);
     if (dup)
       return dup;
 #endif
 
-    const char* str = left_;
+    char* str = left_;
     left_ += len;
     *left_++ = 0;
     checkInvariants();
+#if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+    indexString(str, hash);
+#endif
     return str;
   }
 
+  // The state of the allocations, to undo the ones that follow
+  struct Checkpoint {
+    char* left;
+    char* right;
+    size_t freeVariants;
+  };
+
+  Checkpoint checkpoint() const {
+    Checkpoint result = {left_, right_, freeVariants_};
+    return result;
+  }
+
+  // Releases the strings and the variants allocated since the checkpoint.
+  // Nothing must refer to them anymore, and no variant must have been
+  // released or reused in the meantime.
+  void rollback(Checkpoint checkpoint) {
+    left_ = checkpoint.left;
+    right_ = checkpoint.right;
+    freeVariants_ = checkpoint.freeVariants;
+    checkInvariants();
+  }
+
+  // Makes the next allocations ignore the released variants, so that
+  // rollback() can restore them. Call it after checkpoint().
+  void setReleasedVariantsAside() {
+    freeVariants_ = 0;
+  }
+
   void markAsOverflowed() {
     overflowed_ = true;
   }
@@ -116,7 +173,11 @@ class MemoryPool {
   void clear() {
     left_ = begin_;
     right_ = end_;
+    freeVariants_ = 0;
     overflowed_ = false;
+#if ARDUINOJSON_STRING_INDEX_SIZE
+    index_.clear();
+#endif
   }
 
   bool canAlloc(size_t bytes) const {
@@ -176,7 +237,34 @@ class MemoryPool {
 
 #if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
   template <typename TAdaptedString>
-  const char* findString(const TAdaptedString& str) const {
+  uint32_t hashString(const TAdaptedString& str) const {
+#  if ARDUINOJSON_STRING_INDEX_SIZE
+    return index_.hash(str);
+#  else
+    (void)str;
+    return 0;
+#  endif
+  }
+
+  void indexString(const char* str, uint32_t hash) {
+#  if ARDUINOJSON_STRING_INDEX_SIZE
+    index_.add(begin_, size_t(str - begin_), hash);
+#  else
+    (void)str;
+    (void)hash;
+#  endif
+  }
+
+  template <typename TAdaptedString>
+  const char* findString(const TAdaptedString& str, uint32_t hash) const {
+#  if ARDUINOJSON_STRING_INDEX_SIZE
+    const char* indexed =
+        index_.find(begin_, size_t(left_ - begin_), str, hash);
+    if (indexed || index_.complete())
+      return indexed;
+#  else
+    (void)hash;
+#  endif
     size_t n = str.size();
     for (char* next = begin_; next + n < left_; ++next) {
       if (next[n] == '\0' && stringEquals(str, adaptString(next, n)))
@@ -216,7 +304,28 @@ class MemoryPool {
   }
 
   char *begin_, *left_, *right_, *end_;
+  size_t freeVariants_;  // distance from end_ to the first released slot
   bool overflowed_;
+#if ARDUINOJSON_STRING_INDEX_SIZE
+  StringIndex<ARDUINOJSON_STRING_INDEX_SIZE> index_;
+#endif
+};
+
+// A MemoryPool with a buffer on the stack.
+template <size_t desiredCapacity>
+class StaticMemoryPool : public MemoryPool {
+  static const size_t capacity_ = AddPadding<desiredCapacity>::value;
+
+ public:
+  StaticMemoryPool() : MemoryPool(buffer_.bytes, capacity_) {}
+
+ private:
+  // a union, so the buffer is aligned even if the compiler places it in the
+  // tail padding of MemoryPool
+  union {
+    char bytes[capacity_];
+    void* align;
+  } buffer_;
 };
 
 template <typename TAdaptedString, typename TCallback>
@@ -0,0 +1,38 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Variant/VariantSlot.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Stands in for the memory pool when measuring the capacity of a document.
+// It counts the slots instead of allocating them; each slot is a scratch
+// slot that the next one overwrites.
+class SlotCounter {
+ public:
+  SlotCounter() : count_(0) {}
+
+  VariantSlot* addSlot() {
+    count_++;
+    slot_.clear();
+    return &slot_;
+  }
+
+  size_t count() const {
+    return count_;
+  }
+
+  // Returns the bytes that the memory pool would allocate
+  size_t bytes() const {
+    return count_ * sizeof(VariantSlot);
+  }
+
+ private:
+  size_t count_;
+  VariantSlot slot_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,107 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+
+#include <stdint.h>  // uint32_t
+#include <string.h>  // strlen
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A hash table of the strings of a memory pool, so the deduplication doesn't
+// have to scan the whole pool.
+// It stores the offsets of the strings, so it remains valid when the pool
+// moves, and it ignores the offsets past the end of the strings, so it
+// remains valid when the pool releases memory.
+// Once it's full, it's incomplete: a string that is not in the index may
+// still be in the pool.
+template <size_t capacity>
+class StringIndex {
+ public:
+  StringIndex() {
+    clear();
+  }
+
+  void clear() {
+    for (size_t i = 0; i < capacity; i++)
+      entries_[i] = 0;
+    count_ = 0;
+    complete_ = true;
+  }
+
+  bool complete() const {
+    return complete_;
+  }
+
+  // FNV-1a
+  template <typename TAdaptedString>
+  static uint32_t hash(const TAdaptedString& str) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < str.size(); i++) {
+      h ^= static_cast<uint8_t>(str[i]);
+      h *= 16777619u;
+    }
+    return h;
+  }
+
+  // Finds a string among the size bytes of strings
+  template <typename TAdaptedString>
+  const char* find(const char* strings, size_t size, const TAdaptedString& str,
+                   uint32_t h) const {
+    size_t n = str.size();
+    size_t i = h % capacity;
+    for (size_t probes = 0; probes < capacity && entries_[i]; probes++) {
+      size_t offset = entries_[i] - 1;
+      // a released string may have been replaced by another one, so the
+      // offset can point anywhere in the pool
+      if (offset + n < size && strings[offset + n] == '\0' &&
+          stringEquals(str, adaptString(strings + offset, n)))
+        return strings + offset;
+      i = (i + 1) % capacity;
+    }
+    return 0;
+  }
+
+  // Adds the string at the specified offset, after the other strings.
+  // Rebuilds the index from the strings when it's three quarters full, so
+  // the released strings don't accumulate.
+  void add(const char* strings, size_t offset, uint32_t h) {
+    if (!complete_)
+      return;
+    if (count_ >= capacity / 4 * 3)
+      rebuild(strings, offset);
+    insert(offset, h);
+  }
+
+ private:
+  void insert(size_t offset, uint32_t h) {
+    if (count_ >= capacity / 4 * 3) {
+      complete_ = false;
+      return;
+    }
+    size_t i = h % capacity;
+    while (entries_[i])
+      i = (i + 1) % capacity;
+    entries_[i] = uint32_t(offset + 1);
+    count_++;
+  }
+
+  void rebuild(const char* strings, size_t size) {
+    clear();
+    for (size_t offset = 0; offset < size && complete_;) {
+      size_t n = strlen(strings + offset);
+      insert(offset, hash(adaptString(strings + offset, n)));
+      offset += n + 1;
+    }
+  }
+
+  uint32_t entries_[capacity];  // offset + 1, or 0 if empty
+  size_t count_;
+  bool complete_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
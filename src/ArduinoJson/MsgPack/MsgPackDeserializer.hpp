@@ -11,27 +11,213 @@
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 #include <ArduinoJson/Variant/VariantData.hpp>
 
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+template <typename TReader>
+class MsgPackReader;
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 template <typename TReader, typename TStringStorage>
 class MsgPackDeserializer {
+  template <typename>
+  friend class ArduinoJson::MsgPackReader;
+
  public:
   MsgPackDeserializer(MemoryPool* pool, TReader reader,
                       TStringStorage stringStorage)
       : pool_(pool),
         reader_(reader),
         stringStorage_(stringStorage),
-        foundSomething_(false) {}
+        foundSomething_(false),
+        slotCounter_(0) {}
+
+  // Objects never look for duplicate keys, so AssumeUniqueKeys has no effect
+  template <typename TFilter>
+  DeserializationError parse(VariantData& variant,
+                             const DeserializationOptions<TFilter>& options) {
+    DeserializationError::Code err;
+    err = parseVariant(&variant, options.filter, options.nestingLimit);
+    return foundSomething_ ? err : DeserializationError::EmptyInput;
+  }
 
+  // Parses without building the document: counts the slots in the
+  // SlotCounter, and the strings in the string storage
   template <typename TFilter>
-  DeserializationError parse(VariantData& variant, TFilter filter,
+  DeserializationError measure(SlotCounter& slots,
+                               const DeserializationOptions<TFilter>& options) {
+    VariantData scratch;
+    slotCounter_ = &slots;
+    return parse(scratch, options);
+  }
+
+  template <typename THandler>
+  DeserializationError parse(THandler& handler,
                              DeserializationOption::NestingLimit nestingLimit) {
     DeserializationError::Code err;
-    err = parseVariant(&variant, filter, nestingLimit);
+    err = emitVariant(handler, nestingLimit);
     return foundSomething_ ? err : DeserializationError::EmptyInput;
   }
 
  private:
+  template <typename THandler>
+  DeserializationError::Code emitVariant(
+      THandler& handler, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    uint8_t code = 0;
+    err = readByte(code);
+    if (err)
+      return err;
+
+    foundSomething_ = true;
+
+    switch (code) {
+      case 0xd9:
+        return emitString<uint8_t>(handler);
+
+      case 0xda:
+        return emitString<uint16_t>(handler);
+
+      case 0xdb:
+        return emitString<uint32_t>(handler);
+
+      case 0xdc:
+        return emitArray<uint16_t>(handler, nestingLimit);
+
+      case 0xdd:
+        return emitArray<uint32_t>(handler, nestingLimit);
+
+      case 0xde:
+        return emitObject<uint16_t>(handler, nestingLimit);
+
+      case 0xdf:
+        return emitObject<uint32_t>(handler, nestingLimit);
+    }
+
+    switch (code & 0xf0) {
+      case 0x80:
+        return emitObject(handler, code & 0x0F, nestingLimit);
+
+      case 0x90:
+        return emitArray(handler, code & 0x0F, nestingLimit);
+    }
+
+    if ((code & 0xe0) == 0xa0)
+      return emitString(handler, code & 0x1f);
+
+    // the remaining types are scalars, which don't need the pool
+    VariantData value;
+    err = parseVariant(code, &value, AllowAllFilter(), nestingLimit);
+    if (err)
+      return err;
+
+    HandlerEmitter<THandler> emitter(handler);
+    value.accept(emitter);
+    return DeserializationError::Ok;
+  }
+
+  template <typename T, typename THandler>
+  DeserializationError::Code emitString(THandler& handler) {
+    DeserializationError::Code err;
+    T size;
+
+    err = readInteger(size);
+    if (err)
+      return err;
+
+    return emitString(handler, size);
+  }
+
+  template <typename THandler>
+  DeserializationError::Code emitString(THandler& handler, size_t n) {
+    DeserializationError::Code err;
+
+    err = readString(n);
+    if (err)
+      return err;
+
+    handler.onString(stringStorage_.str());
+    return DeserializationError::Ok;
+  }
+
+  template <typename TSize, typename THandler>
+  DeserializationError::Code emitArray(
+      THandler& handler, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    TSize size;
+
+    err = readInteger(size);
+    if (err)
+      return err;
+
+    return emitArray(handler, size, nestingLimit);
+  }
+
+  template <typename THandler>
+  DeserializationError::Code emitArray(
+      THandler& handler, size_t n,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    if (!handler.onArrayStart())
+      return readArray(0, n, DenyAllFilter(), nestingLimit);
+
+    for (; n; --n) {
+      err = emitVariant(handler, nestingLimit.decrement());
+      if (err)
+        return err;
+    }
+
+    handler.onArrayEnd();
+    return DeserializationError::Ok;
+  }
+
+  template <typename TSize, typename THandler>
+  DeserializationError::Code emitObject(
+      THandler& handler, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+    TSize size;
+
+    err = readInteger(size);
+    if (err)
+      return err;
+
+    return emitObject(handler, size, nestingLimit);
+  }
+
+  template <typename THandler>
+  DeserializationError::Code emitObject(
+      THandler& handler, size_t n,
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    if (!handler.onObjectStart())
+      return readObject(0, n, DenyAllFilter(), nestingLimit);
+
+    for (; n; --n) {
+      err = readKey();
+      if (err)
+        return err;
+
+      if (handler.onKey(stringStorage_.str()))
+        err = emitVariant(handler, nestingLimit.decrement());
+      else
+        err = parseVariant(0, DenyAllFilter(), nestingLimit.decrement());
+      if (err)
+        return err;
+    }
+
+    handler.onObjectEnd();
+    return DeserializationError::Ok;
+  }
+
   template <typename TFilter>
   DeserializationError::Code parseVariant(
       VariantData* variant, TFilter filter,
@@ -45,6 +231,13 @@ class MsgPackDeserializer {
 
     foundSomething_ = true;
 
+    return parseVariant(code, variant, filter, nestingLimit);
+  }
+
+  template <typename TFilter>
+  DeserializationError::Code parseVariant(
+      uint8_t code, VariantData* variant, TFilter filter,
+      DeserializationOption::NestingLimit nestingLimit) {
     bool allowValue = filter.allowValue();
 
     if (allowValue) {
@@ -435,7 +628,7 @@ class MsgPackDeserializer {
 
       if (memberFilter.allow()) {
         ARDUINOJSON_ASSERT(array != 0);
-        value = array->addElement(pool_);
+        value = slotData(addSlot(array));
         if (!value)
           return DeserializationError::NoMemory;
       } else {
@@ -497,7 +690,7 @@ class MsgPackDeserializer {
         // This MUST be done before adding the slot.
         key = stringStorage_.save();
 
-        VariantSlot* slot = object->addSlot(pool_);
+        VariantSlot* slot = addSlot(object);
         if (!slot)
           return DeserializationError::NoMemory;
 
@@ -516,6 +709,13 @@ class MsgPackDeserializer {
     return DeserializationError::Ok;
   }
 
+  // Allocates a slot in the collection, or only counts it when measuring
+  VariantSlot* addSlot(CollectionData* collection) {
+    if (slotCounter_)
+      return slotCounter_->addSlot();
+    return collection->addSlot(pool_);
+  }
+
   DeserializationError::Code readKey() {
     DeserializationError::Code err;
     uint8_t code;
@@ -558,6 +758,7 @@ class MsgPackDeserializer {
   TReader reader_;
   TStringStorage stringStorage_;
   bool foundSomething_;
+  SlotCounter* slotCounter_;  // not null when measuring
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -582,4 +783,72 @@ DeserializationError deserializeMsgPack(JsonDocument& doc, TChar* input,
                                           detail::forward<Args>(args)...);
 }
 
+// Returns the capacity that deserializeMsgPack() needs for this input, with
+// the same filter and options, without building a document.
+// Returns 0 if the input is invalid, or if a string doesn't fit in the heap.
+// The result is exact, except that duplicate keys and the predicate of
+// ElementFilter make it larger, and so does a heap too small to keep the
+// strings to recognize the duplicates.
+// It consumes streams, so measure a buffer and deserialize the same buffer.
+template <typename... Args>
+size_t measureDeserializeMsgPack(Args&&... args) {
+  using namespace detail;
+  return measureDeserialize<MsgPackDeserializer>(
+      detail::forward<Args>(args)...);
+}
+
+// Returns the capacity that deserializeMsgPack() needs for this input, with
+// the same filter and options, without building a document.
+template <typename TChar, typename... Args>
+size_t measureDeserializeMsgPack(TChar* input, Args&&... args) {
+  using namespace detail;
+  return measureDeserialize<MsgPackDeserializer>(
+      input, detail::forward<Args>(args)...);
+}
+
+// Parses a MessagePack input and calls the handler for each token, without
+// building a document.
+// Strings longer than ARDUINOJSON_HANDLER_BUFFER_SIZE - 1 fail with
+// StringTooLong, unless the input is writable (char*).
+template <typename THandler, typename TInput,
+          typename = typename detail::enable_if<
+              detail::IsHandler<THandler>::value>::type>
+DeserializationError deserializeMsgPack(
+    THandler& handler, TInput&& input,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return deserializeToHandler<MsgPackDeserializer>(
+      handler, detail::forward<TInput>(input), nestingLimit);
+}
+
+// Parses a MessagePack input and calls the handler for each token, without
+// building a document.
+// Strings longer than ARDUINOJSON_HANDLER_BUFFER_SIZE - 1 fail with
+// StringTooLong, unless the input is writable (char*).
+template <typename THandler, typename TChar,
+          typename = typename detail::enable_if<
+              detail::IsHandler<THandler>::value>::type>
+DeserializationError deserializeMsgPack(
+    THandler& handler, TChar* input,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return deserializeToHandler<MsgPackDeserializer>(handler, input,
+                                                   nestingLimit);
+}
+
+// Parses a MessagePack input and calls the handler for each token, without
+// building a document.
+// Strings longer than ARDUINOJSON_HANDLER_BUFFER_SIZE - 1 fail with
+// StringTooLong, unless the input is writable (char*).
+template <typename THandler, typename TChar,
+          typename = typename detail::enable_if<
+              detail::IsHandler<THandler>::value>::type>
+DeserializationError deserializeMsgPack(
+    THandler& handler, TChar* input, size_t inputSize,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return deserializeToHandler<MsgPackDeserializer>(handler, input, inputSize,
+                                                   nestingLimit);
+}
+
 ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,320 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/JsonToken.hpp>
+#include <ArduinoJson/Deserialization/ParseStack.hpp>
+#include <ArduinoJson/MsgPack/MsgPackDeserializer.hpp>
+#include <ArduinoJson/StringStorage/StringBuffer.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Reads a MessagePack input one token at a time, without building a document.
+// Use makeMsgPackReader() to create one; the input must outlive the reader.
+template <typename TReader>
+class MsgPackReader {
+  typedef detail::StringBuffer<ARDUINOJSON_HANDLER_BUFFER_SIZE> string_buffer;
+
+ public:
+  MsgPackReader(TReader reader,
+                DeserializationOption::NestingLimit nestingLimit)
+      : parser_(0, reader, string_buffer()),
+        nestingLimit_(nestingLimit),
+        state_(ExpectValue),
+        type_(JsonToken::None),
+        error_(DeserializationError::Ok) {}
+
+  // Moves to the next token.
+  // Returns false at the end of the input, or if an error occurred.
+  bool next() {
+    if (error_)
+      return false;
+
+    switch (state_) {
+      case ExpectValue:
+        return readValue();
+
+      case AfterValue: {
+        if (stack_.empty())
+          return end();
+        Frame& frame = stack_.top();
+        if (frame.remaining == 0)
+          return closeCollection();
+        frame.remaining--;
+        return frame.isObject ? readKey() : readValue();
+      }
+
+      default:
+        return end();
+    }
+  }
+
+  // Skips the value of the current token:
+  // - after ObjectStart or ArrayStart, skips the rest of the collection
+  // - after Key, skips the value of the member
+  // The next call to next() returns the token that follows.
+  bool skipValue() {
+    if (error_)
+      return false;
+
+    DeserializationError::Code err;
+
+    switch (type_) {
+      case JsonToken::ObjectStart:
+      case JsonToken::ArrayStart: {
+        Frame frame = stack_.top();
+        popFrame();
+        if (frame.isObject)
+          err = parser_.readObject(0, frame.remaining, detail::DenyAllFilter(),
+                                   frame.nestingLimit);
+        else
+          err = parser_.readArray(0, frame.remaining, detail::DenyAllFilter(),
+                                  frame.nestingLimit);
+        break;
+      }
+
+      case JsonToken::Key:
+        err = parser_.parseVariant(0, detail::DenyAllFilter(), nestingLimit_);
+        break;
+
+      default:
+        return true;
+    }
+
+    if (err)
+      return fail(err);
+    type_ = JsonToken::None;
+    state_ = AfterValue;
+    return true;
+  }
+
+  JsonToken::Type type() const {
+    return type_;
+  }
+
+  // Returns the number of collections that contain the current token,
+  // including the one that the current ObjectStart or ArrayStart opens.
+  size_t depth() const {
+    return stack_.size();
+  }
+
+  // Returns the key or the string.
+  // The string is only valid until the next call to next().
+  // Strings longer than ARDUINOJSON_HANDLER_BUFFER_SIZE - 1 fail with
+  // DeserializationError::StringTooLong.
+  JsonString getString() {
+    return parser_.stringStorage_.str();
+  }
+
+  int64_t getInt64() const {
+    return value_.asIntegral<int64_t>();
+  }
+
+  JsonFloat getFloat() const {
+    return value_.asFloat<JsonFloat>();
+  }
+
+  bool getBool() const {
+    return value_.asBoolean();
+  }
+
+  DeserializationError error() const {
+    return error_;
+  }
+
+ private:
+  enum State {
+    ExpectValue,
+    AfterValue,  // including after ObjectStart and ArrayStart
+    Done,
+  };
+
+  struct Frame {
+    bool isObject;
+    uint32_t remaining;  // number of elements, or of key-value pairs
+    DeserializationOption::NestingLimit nestingLimit;
+  };
+
+  bool readValue() {
+    DeserializationError::Code err;
+
+    uint8_t code = 0;
+    err = parser_.readByte(code);
+    if (err)
+      return fail(stack_.empty() ? DeserializationError::EmptyInput : err);
+
+    switch (code) {
+      case 0xd9:
+        return readString<uint8_t>();
+
+      case 0xda:
+        return readString<uint16_t>();
+
+      case 0xdb:
+        return readString<uint32_t>();
+
+      case 0xdc:
+        return openCollection<uint16_t>(false);
+
+      case 0xdd:
+        return openCollection<uint32_t>(false);
+
+      case 0xde:
+        return openCollection<uint16_t>(true);
+
+      case 0xdf:
+        return openCollection<uint32_t>(true);
+    }
+
+    switch (code & 0xf0) {
+      case 0x80:
+        return openCollection(true, code & 0x0F);
+
+      case 0x90:
+        return openCollection(false, code & 0x0F);
+    }
+
+    if ((code & 0xe0) == 0xa0)
+      return readString(code & 0x1f);
+
+    // the remaining types are scalars, including the unsupported ones which
+    // read as null
+    value_.setNull();
+    err = parser_.parseVariant(code, &value_, detail::AllowAllFilter(),
+                               nestingLimit_);
+    if (err)
+      return fail(err);
+
+    switch (value_.type()) {
+      case detail::VALUE_IS_NULL:
+        type_ = JsonToken::Null;
+        break;
+
+      case detail::VALUE_IS_BOOLEAN:
+        type_ = JsonToken::Boolean;
+        break;
+
+      case detail::VALUE_IS_FLOAT:
+        type_ = JsonToken::Float;
+        break;
+
+      default:
+        type_ = JsonToken::Integer;
+        break;
+    }
+    state_ = AfterValue;
+    return true;
+  }
+
+  template <typename T>
+  bool readString() {
+    DeserializationError::Code err;
+    T size;
+
+    err = parser_.readInteger(size);
+    if (err)
+      return fail(err);
+
+    return readString(size);
+  }
+
+  bool readString(size_t n) {
+    DeserializationError::Code err = parser_.readString(n);
+    if (err)
+      return fail(err);
+    type_ = JsonToken::String;
+    state_ = AfterValue;
+    return true;
+  }
+
+  bool readKey() {
+    DeserializationError::Code err = parser_.readKey();
+    if (err)
+      return fail(err);
+    type_ = JsonToken::Key;
+    state_ = ExpectValue;
+    return true;
+  }
+
+  template <typename TSize>
+  bool openCollection(bool isObject) {
+    DeserializationError::Code err;
+    TSize size;
+
+    err = parser_.readInteger(size);
+    if (err)
+      return fail(err);
+
+    return openCollection(isObject, size);
+  }
+
+  bool openCollection(bool isObject, uint32_t size) {
+    Frame frame = {isObject, size, nestingLimit_};
+    if (nestingLimit_.reached())
+      return fail(DeserializationError::TooDeep);
+    if (!stack_.push(frame))
+      return fail(DeserializationError::NoMemory);
+    nestingLimit_ = nestingLimit_.decrement();
+    type_ = isObject ? JsonToken::ObjectStart : JsonToken::ArrayStart;
+    state_ = AfterValue;
+    return true;
+  }
+
+  bool closeCollection() {
+    type_ = stack_.top().isObject ? JsonToken::ObjectEnd : JsonToken::ArrayEnd;
+    popFrame();
+    return true;
+  }
+
+  void popFrame() {
+    nestingLimit_ = stack_.top().nestingLimit;
+    stack_.pop();
+  }
+
+  bool end() {
+    state_ = Done;
+    type_ = JsonToken::None;
+    return false;
+  }
+
+  bool fail(DeserializationError::Code err) {
+    error_ = detail::stringTooLongIfNoMemory(err);
+    type_ = JsonToken::None;
+    return false;
+  }
+
+  detail::MsgPackDeserializer<TReader, string_buffer> parser_;
+  DeserializationOption::NestingLimit nestingLimit_;
+  detail::ParseStack<Frame> stack_;
+  State state_;
+  JsonToken::Type type_;
+  DeserializationError::Code error_;
+  detail::VariantData value_;
+};
+
+// Creates a MsgPackReader for the specified input.
+template <typename TInput>
+MsgPackReader<detail::Reader<typename detail::remove_reference<TInput>::type>>
+makeMsgPackReader(TInput&& input, DeserializationOption::NestingLimit
+                                      nestingLimit = {}) {
+  return {detail::makeReader(detail::forward<TInput>(input)), nestingLimit};
+}
+
+// Creates a MsgPackReader for the specified input.
+template <typename TChar>
+MsgPackReader<detail::Reader<TChar*>> makeMsgPackReader(
+    TChar* input, DeserializationOption::NestingLimit nestingLimit = {}) {
+  return {detail::makeReader(input), nestingLimit};
+}
+
+// Creates a MsgPackReader for the specified input.
+template <typename TChar>
+MsgPackReader<detail::BoundedReader<TChar*>> makeMsgPackReader(
+    TChar* input, size_t inputSize,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  return {detail::makeReader(input, inputSize), nestingLimit};
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
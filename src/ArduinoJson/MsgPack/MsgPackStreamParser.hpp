@@ -0,0 +1,471 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Deserialization/ParseStack.hpp>
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/MsgPack/endianness.hpp>
+#include <ArduinoJson/MsgPack/ieee754.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/StringStorage/StringCopier.hpp>
+
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Parses a MessagePack document that arrives in chunks, and puts the result
+// in a JsonDocument.
+// Unlike deserializeMsgPack(), it never waits for the input: feed() consumes
+// the chunk and returns NeedMoreData if the document is not complete yet.
+// The document must not be modified until feed() returns Ok.
+class MsgPackStreamParser {
+ public:
+  MsgPackStreamParser(JsonDocument& doc,
+                      DeserializationOption::NestingLimit nestingLimit =
+                          DeserializationOption::NestingLimit())
+      : doc_(doc),
+        stringStorage_(detail::VariantAttorney::getPool(doc)),
+        maxNestingLimit_(nestingLimit) {
+    reset();
+  }
+
+  // Parses a chunk of input.
+  // Returns Ok once the document is complete, NeedMoreData if it needs another
+  // chunk, or an error.
+  DeserializationError feed(const char* data, size_t size) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+    const uint8_t* end = p + size;
+    if (error_ == DeserializationError::NeedMoreData) {
+      while (p < end && state_ != Done) {
+        error_ = step(p, end);
+        if (error_)
+          break;
+      }
+      if (!error_)
+        error_ = state_ == Done ? DeserializationError::Ok
+                                : DeserializationError::NeedMoreData;
+    }
+    consumed_ = size_t(reinterpret_cast<const char*>(p) - data);
+    return error_;
+  }
+
+  // Tells that there is no more input.
+  // Returns Ok if the document is complete, or an error.
+  DeserializationError finish() {
+    if (error_ == DeserializationError::NeedMoreData)
+      error_ = foundSomething_ ? DeserializationError::IncompleteInput
+                               : DeserializationError::EmptyInput;
+    return error_;
+  }
+
+  // Returns the number of bytes of the last chunk that belong to the document.
+  // After feed() returns Ok, the remaining bytes belong to the next document.
+  size_t consumed() const {
+    return consumed_;
+  }
+
+  // Clears the document and prepares for a new one
+  void reset() {
+    doc_.clear();
+    target_ = detail::VariantAttorney::getData(doc_);
+    nestingLimit_ = maxNestingLimit_;
+    stack_.clear();
+    state_ = ExpectValue;
+    foundSomething_ = false;
+    consumed_ = 0;
+    error_ = DeserializationError::NeedMoreData;
+  }
+
+ private:
+  enum State {
+    ExpectValue,
+    ExpectKey,
+    ReadPayload,  // the fixed-size part that follows the code
+    ReadString,
+    SkipBytes,
+    Done,
+  };
+
+  struct Frame {
+    detail::CollectionData* collection;
+    uint32_t remaining;  // number of elements, or of key-value pairs
+    bool isObject;
+    DeserializationOption::NestingLimit nestingLimit;
+  };
+
+  // Consumes one or more bytes
+  DeserializationError::Code step(const uint8_t*& p, const uint8_t* end) {
+    switch (state_) {
+      case ExpectValue:
+        foundSomething_ = true;
+        return readValueCode(*p++);
+
+      case ExpectKey:
+        return readKeyCode(*p++);
+
+      case ReadPayload: {
+        size_t n = clampSize(end - p, size_t(payloadSize_ - payloadLength_));
+        memcpy(payload_ + payloadLength_, p, n);
+        p += n;
+        payloadLength_ = uint8_t(payloadLength_ + n);
+        if (payloadLength_ < payloadSize_)
+          return DeserializationError::Ok;
+        return readPayload();
+      }
+
+      case ReadString: {
+        size_t n = clampSize(end - p, remaining_);
+        stringStorage_.append(reinterpret_cast<const char*>(p), n);
+        p += n;
+        remaining_ -= uint32_t(n);
+        if (remaining_ > 0)
+          return DeserializationError::Ok;
+        return endString();
+      }
+
+      case SkipBytes: {
+        size_t n = clampSize(end - p, remaining_);
+        p += n;
+        remaining_ -= uint32_t(n);
+        if (remaining_ > 0)
+          return DeserializationError::Ok;
+        return endValue();
+      }
+
+      default:
+        ARDUINOJSON_ASSERT(false);
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  DeserializationError::Code readValueCode(uint8_t code) {
+    if (!stack_.empty() && !stack_.top().isObject) {
+      target_ = stack_.top().collection->addElement(pool());
+      if (!target_)
+        return DeserializationError::NoMemory;
+    }
+
+    code_ = code;
+    isKey_ = false;
+
+    switch (code) {
+      case 0xc0:
+        // already null
+        return endValue();
+
+      case 0xc1:
+        return DeserializationError::InvalidInput;
+
+      case 0xc2:
+        target_->setBoolean(false);
+        return endValue();
+
+      case 0xc3:
+        target_->setBoolean(true);
+        return endValue();
+
+      case 0xc4:  // bin 8 (not supported)
+      case 0xc7:  // ext 8 (not supported)
+      case 0xcc:
+      case 0xd0:
+      case 0xd9:
+        return startPayload(1);
+
+      case 0xc5:  // bin 16 (not supported)
+      case 0xc8:  // ext 16 (not supported)
+      case 0xcd:
+      case 0xd1:
+      case 0xda:
+      case 0xdc:
+      case 0xde:
+        return startPayload(2);
+
+      case 0xc6:  // bin 32 (not supported)
+      case 0xc9:  // ext 32 (not supported)
+      case 0xca:
+      case 0xce:
+      case 0xd2:
+      case 0xdb:
+      case 0xdd:
+      case 0xdf:
+        return startPayload(4);
+
+      case 0xcb:
+      case 0xcf:
+      case 0xd3:
+        return startPayload(8);
+
+      case 0xd4:  // fixext 1 (not supported)
+        return skipBytes(2);
+
+      case 0xd5:  // fixext 2 (not supported)
+        return skipBytes(3);
+
+      case 0xd6:  // fixext 4 (not supported)
+        return skipBytes(5);
+
+      case 0xd7:  // fixext 8 (not supported)
+        return skipBytes(9);
+
+      case 0xd8:  // fixext 16 (not supported)
+        return skipBytes(17);
+    }
+
+    switch (code & 0xf0) {
+      case 0x80:
+        return openCollection(target_->toObject(), true, code & 0x0F);
+
+      case 0x90:
+        return openCollection(target_->toArray(), false, code & 0x0F);
+    }
+
+    if ((code & 0xe0) == 0xa0)
+      return startString(code & 0x1f);
+
+    target_->setInteger(static_cast<int8_t>(code));
+    return endValue();
+  }
+
+  DeserializationError::Code readKeyCode(uint8_t code) {
+    code_ = code;
+    isKey_ = true;
+
+    if ((code & 0xe0) == 0xa0)
+      return startString(code & 0x1f);
+
+    switch (code) {
+      case 0xd9:
+        return startPayload(1);
+
+      case 0xda:
+        return startPayload(2);
+
+      case 0xdb:
+        return startPayload(4);
+
+      default:
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  // Called when the fixed-size part that follows code_ is complete
+  DeserializationError::Code readPayload() {
+    switch (code_) {
+      case 0xc4:
+        return skipBytes(payload<uint8_t>());
+
+      case 0xc5:
+        return skipBytes(payload<uint16_t>());
+
+      case 0xc6:
+        return skipBytes(payload<uint32_t>());
+
+      case 0xc7:
+        return skipBytes(payload<uint8_t>() + 1U);
+
+      case 0xc8:
+        return skipBytes(payload<uint16_t>() + 1U);
+
+      case 0xc9:
+        return skipBytes(payload<uint32_t>() + 1U);
+
+      case 0xca:
+        target_->setFloat(payload<float>());
+        return endValue();
+
+      case 0xcb:
+        target_->setFloat(static_cast<JsonFloat>(payloadDouble<double>()));
+        return endValue();
+
+      case 0xcc:
+        target_->setInteger(payload<uint8_t>());
+        return endValue();
+
+      case 0xcd:
+        target_->setInteger(payload<uint16_t>());
+        return endValue();
+
+      case 0xce:
+        target_->setInteger(payload<uint32_t>());
+        return endValue();
+
+#if ARDUINOJSON_USE_LONG_LONG
+      case 0xcf:
+        target_->setInteger(payload<uint64_t>());
+        return endValue();
+#endif
+
+      case 0xd0:
+        target_->setInteger(payload<int8_t>());
+        return endValue();
+
+      case 0xd1:
+        target_->setInteger(payload<int16_t>());
+        return endValue();
+
+      case 0xd2:
+        target_->setInteger(payload<int32_t>());
+        return endValue();
+
+#if ARDUINOJSON_USE_LONG_LONG
+      case 0xd3:
+        target_->setInteger(payload<int64_t>());
+        return endValue();
+#endif
+
+      case 0xd9:
+        return startString(payload<uint8_t>());
+
+      case 0xda:
+        return startString(payload<uint16_t>());
+
+      case 0xdb:
+        return startString(payload<uint32_t>());
+
+      case 0xdc:
+        return openCollection(target_->toArray(), false, payload<uint16_t>());
+
+      case 0xdd:
+        return openCollection(target_->toArray(), false, payload<uint32_t>());
+
+      case 0xde:
+        return openCollection(target_->toObject(), true, payload<uint16_t>());
+
+      case 0xdf:
+        return openCollection(target_->toObject(), true, payload<uint32_t>());
+
+      default:  // 64-bit integers (not supported)
+        return endValue();
+    }
+  }
+
+  DeserializationError::Code startPayload(uint8_t size) {
+    payloadSize_ = size;
+    payloadLength_ = 0;
+    state_ = ReadPayload;
+    return DeserializationError::Ok;
+  }
+
+  template <typename T>
+  T payload() {
+    T value;
+    memcpy(&value, payload_, sizeof(value));
+    detail::fixEndianness(value);
+    return value;
+  }
+
+  template <typename T>
+  typename detail::enable_if<sizeof(T) == 8, T>::type payloadDouble() {
+    return payload<T>();
+  }
+
+  template <typename T>
+  typename detail::enable_if<sizeof(T) == 4, T>::type payloadDouble() {
+    T value;
+    detail::doubleToFloat(payload_, reinterpret_cast<uint8_t*>(&value));
+    detail::fixEndianness(value);
+    return value;
+  }
+
+  DeserializationError::Code startString(uint32_t size) {
+    stringStorage_.startString();
+    remaining_ = size;
+    state_ = ReadString;
+    if (size == 0)
+      return endString();
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code endString() {
+    if (!stringStorage_.isValid())
+      return DeserializationError::NoMemory;
+
+    if (!isKey_) {
+      target_->setString(stringStorage_.save());
+      return endValue();
+    }
+
+    // Save key in memory pool.
+    // This MUST be done before adding the slot.
+    JsonString key = stringStorage_.save();
+
+    detail::VariantSlot* slot = stack_.top().collection->addSlot(pool());
+    if (!slot)
+      return DeserializationError::NoMemory;
+
+    slot->setKey(key);
+    target_ = slot->data();
+    state_ = ExpectValue;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code skipBytes(uint32_t size) {
+    remaining_ = size;
+    state_ = SkipBytes;
+    if (size == 0)
+      return endValue();
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code openCollection(detail::CollectionData& collection,
+                                            bool isObject, uint32_t size) {
+    if (nestingLimit_.reached())
+      return DeserializationError::TooDeep;
+    if (size == 0)
+      return endValue();
+    Frame frame = {&collection, size, isObject, nestingLimit_};
+    if (!stack_.push(frame))
+      return DeserializationError::NoMemory;
+    nestingLimit_ = nestingLimit_.decrement();
+    state_ = isObject ? ExpectKey : ExpectValue;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code endValue() {
+    while (!stack_.empty()) {
+      Frame& frame = stack_.top();
+      if (--frame.remaining > 0) {
+        state_ = frame.isObject ? ExpectKey : ExpectValue;
+        return DeserializationError::Ok;
+      }
+      // the collection is complete, so it's a value in its parent
+      nestingLimit_ = frame.nestingLimit;
+      stack_.pop();
+    }
+    state_ = Done;
+    return DeserializationError::Ok;
+  }
+
+  detail::MemoryPool* pool() {
+    return detail::VariantAttorney::getPool(doc_);
+  }
+
+  static size_t clampSize(ptrdiff_t available, size_t needed) {
+    return size_t(available) < needed ? size_t(available) : needed;
+  }
+
+  JsonDocument& doc_;
+  detail::StringCopier stringStorage_;
+  DeserializationOption::NestingLimit maxNestingLimit_;
+  DeserializationOption::NestingLimit nestingLimit_;
+  detail::ParseStack<Frame> stack_;
+  State state_;
+  DeserializationError::Code error_;
+  size_t consumed_;
+  bool foundSomething_;
+  detail::VariantData* target_;
+
+  // state of the current value
+  uint8_t code_;
+  bool isKey_;
+  uint8_t payload_[8];
+  uint8_t payloadSize_;
+  uint8_t payloadLength_;
+  uint32_t remaining_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
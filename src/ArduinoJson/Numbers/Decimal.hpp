@@ -0,0 +1,254 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>  // memmove
+
+#include <ArduinoJson/Namespace.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A decimal number with up to 800 significant digits, enough to round any
+// input to the nearest double.
+// This is the slow path of the float parser: it only runs when the
+// Eisel-Lemire algorithm cannot decide. The algorithm comes from the
+// "decimal" type of Go's strconv package.
+class Decimal {
+ public:
+  Decimal() : size_(0), point_(0), truncated_(false) {}
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  // Appends a digit (0-9) after the existing ones
+  void append(uint8_t digit) {
+    if (size_ < capacity)
+      digits_[size_++] = digit;
+    else if (digit != 0)
+      truncated_ = true;
+  }
+
+  // Appends the digits of n after the existing ones
+  void append(uint64_t n) {
+    uint8_t reversed[20];
+    int count = 0;
+    do {
+      reversed[count++] = uint8_t(n % 10);
+      n /= 10;
+    } while (n);
+    while (count > 0)
+      append(reversed[--count]);
+  }
+
+  // Sets the position of the decimal point; the value is 0.DIGITS * 10^point
+  void setDecimalPoint(int point) {
+    point_ = point;
+  }
+
+  // Returns the binary representation of the nearest double.
+  // Modifies the digits in the process.
+  uint64_t toDoubleBits() {
+    const int mantissaBits = 52;
+    const int bias = -1023;
+    const int maxExponent = 0x7FF;
+    const uint64_t infinity = uint64_t(maxExponent) << mantissaBits;
+
+    if (size_ == 0 || point_ < -330)
+      return 0;
+    if (point_ > 310)
+      return infinity;
+
+    // scale by powers of two until the value is in [0.5, 1)
+    int exponent = 0;
+    while (point_ > 0) {
+      int n = point_ < powerTableSize ? powerTable(point_) : 27;
+      shift(-n);
+      exponent += n;
+    }
+    while (point_ < 0 || (point_ == 0 && digits_[0] < 5)) {
+      int n = -point_ < powerTableSize ? powerTable(-point_) : 27;
+      shift(n);
+      exponent -= n;
+    }
+
+    // the range of a double mantissa is [1, 2)
+    exponent--;
+
+    // subnormal numbers have the smallest exponent
+    if (exponent < bias + 1) {
+      int n = bias + 1 - exponent;
+      shift(-n);
+      exponent += n;
+    }
+
+    if (exponent - bias >= maxExponent)
+      return infinity;
+
+    shift(1 + mantissaBits);
+    uint64_t mantissa = roundedInteger();
+
+    // rounding may have added a bit
+    if (mantissa == uint64_t(2) << mantissaBits) {
+      mantissa >>= 1;
+      exponent++;
+      if (exponent - bias >= maxExponent)
+        return infinity;
+    }
+
+    if (!(mantissa & (uint64_t(1) << mantissaBits)))  // subnormal
+      exponent = bias;
+
+    return (mantissa & ((uint64_t(1) << mantissaBits) - 1)) |
+           (uint64_t(exponent - bias) << mantissaBits);
+  }
+
+ private:
+  static const int capacity = 800;
+
+  // a shift can't exceed 60 bits, to leave room for a digit in a uint64_t
+  static const int maxShift = 60;
+
+  // a shift by k bits adds at most k * 3 / 10 + 1 digits
+  static const int maxShiftDigits = maxShift * 3 / 10 + 1;
+
+  static const int powerTableSize = 9;
+
+  // Returns the number of bits needed to shift by 10^n
+  static int powerTable(int n) {
+    static const uint8_t table[powerTableSize] = {1,  3,  6,  9, 13,
+                                                  16, 19, 23, 26};
+    return table[n];
+  }
+
+  // Multiplies by 2^k (k > 0) or divides by 2^-k (k < 0)
+  void shift(int k) {
+    if (size_ == 0)
+      return;
+    if (k > 0) {
+      for (; k > maxShift; k -= maxShift)
+        leftShift(maxShift);
+      leftShift(k);
+    } else if (k < 0) {
+      for (; k < -maxShift; k += maxShift)
+        rightShift(maxShift);
+      rightShift(-k);
+    }
+  }
+
+  void leftShift(int k) {
+    // write the new digits from right to left, starting far enough so that
+    // the unread digits are never overwritten
+    int maxDelta = k * 3 / 10 + 1;
+    int read = size_;
+    int write = size_ + maxDelta;
+    uint64_t n = 0;
+    while (read > 0) {
+      n += uint64_t(digits_[--read]) << k;
+      uint64_t quotient = n / 10;
+      digits_[--write] = uint8_t(n - 10 * quotient);
+      n = quotient;
+    }
+    while (n > 0) {
+      uint64_t quotient = n / 10;
+      digits_[--write] = uint8_t(n - 10 * quotient);
+      n = quotient;
+    }
+
+    int newSize = size_ + maxDelta - write;
+    memmove(digits_, digits_ + write, size_t(newSize));
+    point_ += newSize - size_;
+    if (newSize > capacity) {
+      for (int i = capacity; i < newSize; i++) {
+        if (digits_[i])
+          truncated_ = true;
+      }
+      newSize = capacity;
+    }
+    size_ = newSize;
+    trim();
+  }
+
+  void rightShift(int k) {
+    int read = 0;
+    int write = 0;
+
+    // pick up enough leading digits to cover the first shift
+    uint64_t n = 0;
+    for (; (n >> k) == 0; read++) {
+      if (read >= size_) {
+        while ((n >> k) == 0) {
+          n *= 10;
+          read++;
+        }
+        break;
+      }
+      n = n * 10 + digits_[read];
+    }
+    point_ -= read - 1;
+
+    const uint64_t mask = (uint64_t(1) << k) - 1;
+
+    // pick up a digit, put down a digit
+    for (; read < size_; read++) {
+      digits_[write++] = uint8_t(n >> k);
+      n = (n & mask) * 10 + digits_[read];
+    }
+
+    // put down the extra digits
+    while (n > 0) {
+      uint8_t digit = uint8_t(n >> k);
+      n = (n & mask) * 10;
+      if (write < capacity)
+        digits_[write++] = digit;
+      else if (digit > 0)
+        truncated_ = true;
+    }
+
+    size_ = write;
+    trim();
+  }
+
+  void trim() {
+    while (size_ > 0 && digits_[size_ - 1] == 0)
+      size_--;
+    if (size_ == 0)
+      point_ = 0;
+  }
+
+  // Returns the integral part, rounded to the nearest (ties to even)
+  uint64_t roundedInteger() const {
+    if (point_ > 20)
+      return uint64_t(-1);
+    uint64_t n = 0;
+    int i = 0;
+    for (; i < point_ && i < size_; i++)
+      n = n * 10 + digits_[i];
+    for (; i < point_; i++)
+      n *= 10;
+    if (shouldRoundUp(point_))
+      n++;
+    return n;
+  }
+
+  bool shouldRoundUp(int i) const {
+    if (i < 0 || i >= size_)
+      return false;
+    if (digits_[i] == 5 && i + 1 == size_) {  // exactly halfway
+      if (truncated_)  // slightly above
+        return true;
+      return i > 0 && digits_[i - 1] % 2 == 1;
+    }
+    return digits_[i] >= 5;
+  }
+
+  uint8_t digits_[capacity + maxShiftDigits];
+  int size_;
+  int point_;
+  bool truncated_;  // some non-zero digits were dropped
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -5,70 +5,217 @@
 #pragma once
 
 #include <ArduinoJson/Numbers/FloatTraits.hpp>
+#if ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+#  include <ArduinoJson/Numbers/Decimal.hpp>
+#  include <ArduinoJson/Numbers/eiselLemire.hpp>
+#endif
 #include <ArduinoJson/Numbers/convertNumber.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/attributes.hpp>
 #include <ArduinoJson/Polyfills/ctype.hpp>
 #include <ArduinoJson/Polyfills/math.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 #include <ArduinoJson/Variant/Converter.hpp>
 #include <ArduinoJson/Variant/VariantData.hpp>
 
+#include <string.h>  // memcpy
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 template <typename A, typename B>
 struct choose_largest : conditional<(sizeof(A) > sizeof(B)), A, B> {};
 
-inline bool parseNumber(const char* s, VariantData& result) {
+#if ARDUINOJSON_USE_LONG_LONG && ARDUINOJSON_LITTLE_ENDIAN
+// Returns true if the 8 bytes of the word are digits
+inline bool isEightDigits(uint64_t word) {
+  return !(((word + 0x4646464646464646) | (word - 0x3030303030303030)) &
+           0x8080808080808080);
+}
+
+// Converts 8 digits to an integer, in three multiplications instead of eight
+// See "Faster Integer Parsing" by Kholdstare
+inline uint32_t parseEightDigits(uint64_t word) {
+  const uint64_t mask = 0x000000FF000000FF;
+  const uint64_t mul1 = 0x000F424000000064;  // 100 + (1000000 << 32)
+  const uint64_t mul2 = 0x0000271000000001;  // 1 + (10000 << 32)
+  word -= 0x3030303030303030;
+  word = (word * 10) + (word >> 8);
+  word = (((word & mask) * mul1) + (((word >> 16) & mask) * mul2)) >> 32;
+  return uint32_t(word);
+}
+
+// Reads 8 digits at once when the input is contiguous
+template <typename TLatch>
+inline bool readEightDigits(TLatch& latch, uint32_t& value) {
+  const char* p = latch.begin();
+  if (latch.end() - p < 8)
+    return false;
+  uint64_t word;
+  memcpy(&word, p, 8);
+  if (!isEightDigits(word))
+    return false;
+  value = parseEightDigits(word);
+  latch.seek(p + 8);
+  return true;
+}
+#endif
+
+// Skips the rest of "NaN" or "Infinity"
+template <typename TLatch>
+inline void skipNumberWord(TLatch& latch) {
+  for (;;) {
+    char c = latch.current();
+    if (!isdigit(c) && !issign(c) && c != '.' && !('A' <= c && c <= 'Z') &&
+        !('a' <= c && c <= 'z'))
+      return;
+    latch.clear();
+  }
+}
+
+#if ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+// Appends a digit to the significand, or to the decimal once the significand
+// has 19 digits. Returns true in the former case.
+inline bool appendDigit(uint64_t& significand, Decimal& decimal,
+                        uint8_t digit) {
+  if (decimal.empty() && significand < 1000000000000000000) {
+    significand = significand * 10 + digit;
+    return true;
+  }
+  if (decimal.empty())
+    decimal.append(significand);
+  decimal.append(digit);
+  return false;
+}
+
+// Parses the rest of a float whose integral digits are in significand, and
+// returns the nearest double.
+// The 19 first significant digits are enough for the Eisel-Lemire algorithm
+// in most cases; the other ones are kept in a Decimal for the slow path.
+// This function is out of line so the Decimal never lands in the stack frame
+// of the recursive deserializer.
+template <typename TLatch>
+NO_INLINE JsonFloat parseExactFloat(TLatch& latch, uint64_t significand) {
+  Decimal decimal;
+  int exponent = 0;  // value = (significand + 0.decimal) * 10^exponent
+
+  if (significand >= 10000000000000000000u) {  // 20 digits
+    decimal.append(significand);
+    significand /= 10;
+    exponent++;
+  }
+
+  for (; isdigit(latch.current()); latch.clear()) {
+    if (!appendDigit(significand, decimal, uint8_t(latch.current() - '0')))
+      exponent++;
+  }
+
+  if (latch.current() == '.') {
+    latch.clear();
+    for (; isdigit(latch.current()); latch.clear()) {
+      if (appendDigit(significand, decimal, uint8_t(latch.current() - '0')))
+        exponent--;
+    }
+  }
+
+  if (latch.current() == 'e' || latch.current() == 'E') {
+    latch.clear();
+    bool negative_exponent = false;
+    if (latch.current() == '-') {
+      negative_exponent = true;
+      latch.clear();
+    } else if (latch.current() == '+') {
+      latch.clear();
+    }
+    int explicit_exponent = 0;
+    for (; isdigit(latch.current()); latch.clear()) {
+      if (explicit_exponent < 100000)  // large enough to saturate
+        explicit_exponent = explicit_exponent * 10 + (latch.current() - '0');
+    }
+    exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+  }
+
+  // when digits were dropped, the value is between significand and
+  // significand + 1, so both must round to the same double
+  uint64_t bits, upperBits;
+  if (eiselLemire(significand, exponent, bits) &&
+      (decimal.empty() ||
+       (eiselLemire(significand + 1, exponent, upperBits) &&
+        bits == upperBits)))
+    return FloatTraits<JsonFloat>::forge(bits);
+
+  int point = exponent;
+  for (uint64_t n = significand; n; n /= 10)
+    point++;
+  if (decimal.empty())
+    decimal.append(significand);
+  decimal.setDecimalPoint(point);
+  return FloatTraits<JsonFloat>::forge(decimal.toDoubleBits());
+}
+#endif
+
+// Parses a number and consumes its characters from the latch.
+// The latch is a Latch or anything with the same interface.
+// Stops at the first character that cannot continue the number, so the caller
+// must check what follows.
+template <typename TLatch>
+inline bool parseNumber(TLatch& latch, VariantData& result) {
   typedef FloatTraits<JsonFloat> traits;
   typedef choose_largest<traits::mantissa_type, JsonUInt>::type mantissa_t;
-  typedef traits::exponent_type exponent_t;
-
-  ARDUINOJSON_ASSERT(s != 0);
 
   bool is_negative = false;
-  switch (*s) {
+  switch (latch.current()) {
     case '-':
       is_negative = true;
-      s++;
+      latch.clear();
       break;
     case '+':
-      s++;
+      latch.clear();
       break;
   }
 
 #if ARDUINOJSON_ENABLE_NAN
-  if (*s == 'n' || *s == 'N') {
+  if (latch.current() == 'n' || latch.current() == 'N') {
+    skipNumberWord(latch);
     result.setFloat(traits::nan());
     return true;
   }
 #endif
 
 #if ARDUINOJSON_ENABLE_INFINITY
-  if (*s == 'i' || *s == 'I') {
+  if (latch.current() == 'i' || latch.current() == 'I') {
+    skipNumberWord(latch);
     result.setFloat(is_negative ? -traits::inf() : traits::inf());
     return true;
   }
 #endif
 
-  if (!isdigit(*s) && *s != '.')
+  if (!isdigit(latch.current()) && latch.current() != '.')
     return false;
 
   mantissa_t mantissa = 0;
-  exponent_t exponent_offset = 0;
   const mantissa_t maxUint = JsonUInt(-1);
 
-  while (isdigit(*s)) {
-    uint8_t digit = uint8_t(*s - '0');
+#if ARDUINOJSON_USE_LONG_LONG && ARDUINOJSON_LITTLE_ENDIAN
+  uint32_t eightDigits;
+  while (mantissa <= (maxUint - 99999999) / 100000000 &&
+         readEightDigits(latch, eightDigits)) {
+    mantissa = mantissa * 100000000 + eightDigits;
+  }
+#endif
+
+  while (isdigit(latch.current())) {
+    uint8_t digit = uint8_t(latch.current() - '0');
     if (mantissa > maxUint / 10)
       break;
     mantissa *= 10;
     if (mantissa > maxUint - digit)
       break;
     mantissa += digit;
-    s++;
+    latch.clear();
   }
 
-  if (*s == '\0') {
+  char c = latch.current();
+  if (!isdigit(c) && c != '.' && c != 'e' && c != 'E') {
     if (is_negative) {
       const mantissa_t sintMantissaMax = mantissa_t(1)
                                          << (sizeof(JsonInteger) * 8 - 1);
@@ -82,6 +229,14 @@ inline bool parseNumber(const char* s, VariantData& result) {
     }
   }
 
+#if ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+  JsonFloat value = parseExactFloat(latch, mantissa);
+  result.setFloat(is_negative ? -value : value);
+  return true;
+#else
+  typedef traits::exponent_type exponent_t;
+  exponent_t exponent_offset = 0;
+
   // avoid mantissa overflow
   while (mantissa > traits::mantissa_max) {
     mantissa /= 10;
@@ -89,58 +244,142 @@ inline bool parseNumber(const char* s, VariantData& result) {
   }
 
   // remaing digits can't fit in the mantissa
-  while (isdigit(*s)) {
+  while (isdigit(latch.current())) {
     exponent_offset++;
-    s++;
+    latch.clear();
   }
 
-  if (*s == '.') {
-    s++;
-    while (isdigit(*s)) {
+  if (latch.current() == '.') {
+    latch.clear();
+#if ARDUINOJSON_USE_LONG_LONG && ARDUINOJSON_LITTLE_ENDIAN
+    // all eight digits must fit, see the loop below
+    const mantissa_t eightDigitsMax =
+        traits::mantissa_max / 10 > 9999999
+            ? (traits::mantissa_max / 10 - 9999999) / 10000000
+            : 0;
+    while (mantissa < eightDigitsMax && readEightDigits(latch, eightDigits)) {
+      mantissa = mantissa * 100000000 + eightDigits;
+      exponent_offset = exponent_t(exponent_offset - 8);
+    }
+#endif
+    while (isdigit(latch.current())) {
       if (mantissa < traits::mantissa_max / 10) {
-        mantissa = mantissa * 10 + uint8_t(*s - '0');
+        mantissa = mantissa * 10 + uint8_t(latch.current() - '0');
         exponent_offset--;
       }
-      s++;
+      latch.clear();
     }
   }
 
   int exponent = 0;
-  if (*s == 'e' || *s == 'E') {
-    s++;
+  if (latch.current() == 'e' || latch.current() == 'E') {
+    latch.clear();
     bool negative_exponent = false;
-    if (*s == '-') {
+    if (latch.current() == '-') {
       negative_exponent = true;
-      s++;
-    } else if (*s == '+') {
-      s++;
+      latch.clear();
+    } else if (latch.current() == '+') {
+      latch.clear();
     }
 
-    while (isdigit(*s)) {
-      exponent = exponent * 10 + (*s - '0');
+    while (isdigit(latch.current())) {
+      exponent = exponent * 10 + (latch.current() - '0');
+      latch.clear();
       if (exponent + exponent_offset > traits::exponent_max) {
+        while (isdigit(latch.current()))
+          latch.clear();
         if (negative_exponent)
           result.setFloat(is_negative ? -0.0f : 0.0f);
         else
           result.setFloat(is_negative ? -traits::inf() : traits::inf());
         return true;
       }
-      s++;
     }
     if (negative_exponent)
       exponent = -exponent;
   }
   exponent += exponent_offset;
 
-  // we should be at the end of the string, otherwise it's an error
-  if (*s != '\0')
-    return false;
-
   JsonFloat final_result =
       make_float(static_cast<JsonFloat>(mantissa), exponent);
 
   result.setFloat(is_negative ? -final_result : final_result);
   return true;
+#endif
+}
+
+// Reads a null-terminated string with the same interface as Latch
+class StringLatch {
+ public:
+  StringLatch(const char* s) : ptr_(s) {}
+
+  char current() const {
+    return *ptr_;
+  }
+
+  void clear() {
+    ptr_++;
+  }
+
+  // the end is unknown, so there is nothing to scan
+  const char* begin() const {
+    return 0;
+  }
+
+  const char* end() const {
+    return 0;
+  }
+
+  void seek(const char*) {}
+
+ private:
+  const char* ptr_;
+};
+
+inline bool parseNumber(const char* s, VariantData& result) {
+  ARDUINOJSON_ASSERT(s != 0);
+
+  StringLatch latch(s);
+  VariantData value;
+
+  // we should be at the end of the string, otherwise it's an error
+  if (!parseNumber(latch, value) || latch.current() != '\0')
+    return false;
+
+  result = value;
+  return true;
+}
+
+// Returns true if the string follows the number grammar of RFC 8259, which
+// is stricter than parseNumber()
+inline bool isStrictJsonNumber(const char* s) {
+  if (*s == '-')
+    s++;
+  if (*s == '0') {
+    s++;
+  } else if (isdigit(*s)) {
+    while (isdigit(*s))
+      s++;
+  } else {
+    return false;
+  }
+  if (*s == '.') {
+    s++;
+    if (!isdigit(*s))
+      return false;
+    while (isdigit(*s))
+      s++;
+  }
+  if (*s == 'e' || *s == 'E') {
+    s++;
+    if (*s == '+' || *s == '-')
+      s++;
+    if (!isdigit(*s))
+      return false;
+    while (isdigit(*s))
+      s++;
+  }
+  return *s == '\0';
 }
 
 template <typename T>
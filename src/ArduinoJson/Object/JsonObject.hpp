@@ -84,12 +84,12 @@ class JsonObject : public detail::VariantOperators<JsonObject> {
   }
 
   // Removes all the members of the object.
-  // ⚠️ Doesn't release the memory associated with the removed members.
+  // ⚠️ Recycles the slots of the removed members, but not their strings.
   // https://arduinojson.org/v6/api/jsonobject/clear/
   void clear() const {
     if (!data_)
       return;
-    data_->clear();
+    data_->removeAll(pool_);
   }
 
   // Copies an object.
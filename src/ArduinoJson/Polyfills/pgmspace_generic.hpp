@@ -37,6 +37,12 @@ inline float pgm_read(const float* p) {
   return pgm_read_float(p);
 }
 
+inline uint64_t pgm_read(const uint64_t* p) {
+  uint64_t result;
+  memcpy_P(&result, p, sizeof(result));
+  return result;
+}
+
 #else
 
 #  ifndef ARDUINOJSON_DEFINE_PROGMEM_ARRAY
@@ -0,0 +1,67 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Strings/JsonString.hpp>
+
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A string storage that keeps only the last string in a fixed-size buffer.
+// Unlike StringCopier, it owns its buffer, so it can be copied.
+template <size_t capacity>
+class StringBuffer {
+ public:
+  StringBuffer() : size_(0), overflowed_(false) {}
+
+  void startString() {
+    size_ = 0;
+    overflowed_ = false;
+  }
+
+  JsonString save() {
+    return str();
+  }
+
+  void append(const char* s, size_t n) {
+    if (size_ + n < capacity) {
+      memcpy(buffer_ + size_, s, n);
+      size_ += n;
+    } else {
+      overflowed_ = true;
+    }
+  }
+
+  void append(char c) {
+    if (size_ + 1 < capacity)
+      buffer_[size_++] = c;
+    else
+      overflowed_ = true;
+  }
+
+  bool isValid() const {
+    return !overflowed_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  JsonString str() {
+    ARDUINOJSON_ASSERT(size_ < capacity);
+    buffer_[size_] = 0;
+    return JsonString(buffer_, size_, JsonString::Linked);
+  }
+
+ private:
+  char buffer_[capacity];
+  size_t size_;
+  bool overflowed_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
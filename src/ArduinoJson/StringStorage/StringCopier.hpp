@@ -6,6 +6,8 @@
 
 #include <ArduinoJson/Memory/MemoryPool.hpp>
 
+#include <string.h>  // memcpy
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 class StringCopier {
@@ -32,8 +34,12 @@ class StringCopier {
   }
 
   void append(const char* s, size_t n) {
-    while (n-- > 0)
-      append(*s++);
+    if (size_ + n < capacity_) {
+      memcpy(ptr_ + size_, s, n);
+      size_ += n;
+    } else {
+      pool_->markAsOverflowed();
+    }
   }
 
   void append(char c) {
@@ -0,0 +1,221 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2023, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/DefaultAllocator.hpp>
+#include <ArduinoJson/Memory/StringIndex.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/StringStorage/StringCopier.hpp>
+
+#include <string.h>  // memcmp, memcpy, memmove
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Tells whether a string storage saves the strings in the memory pool
+template <typename TStringStorage>
+struct CopiesStrings : is_same<TStringStorage, StringCopier> {};
+
+// The strings seen by measureDeserializeJson() and measureDeserializeMsgPack().
+// Counts the bytes that the memory pool would allocate for them.
+// When the pool deduplicates the strings, it keeps them in a buffer from the
+// allocator to recognize the duplicates; otherwise, it only keeps the current
+// string. If the allocator fails, it forgets the previous strings, so the
+// duplicates count twice, and only overflows if the current string doesn't
+// fit.
+template <typename TAllocator = DefaultAllocator>
+class CountedStrings {
+ public:
+  CountedStrings()
+      : buffer_(0),
+        capacity_(0),
+        kept_(0),
+        size_(0),
+        bytes_(0),
+        overflowed_(false) {}
+
+  ~CountedStrings() {
+    if (buffer_)
+      allocator_.deallocate(buffer_);
+  }
+
+  CountedStrings(const CountedStrings&) = delete;
+  CountedStrings& operator=(const CountedStrings&) = delete;
+
+  // Returns the bytes that the memory pool would allocate
+  size_t bytes() const {
+    return bytes_;
+  }
+
+  bool overflowed() const {
+    return overflowed_;
+  }
+
+  void startString() {
+    size_ = 0;
+    reserve(1);
+  }
+
+  void append(const char* s, size_t n) {
+    if (reserve(size_ + n + 1)) {
+      memcpy(current() + size_, s, n);
+      size_ += n;
+    }
+  }
+
+  void append(char c) {
+    if (reserve(size_ + 2))
+      current()[size_++] = c;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  JsonString str() const {
+    if (!buffer_)  // the allocator failed in startString()
+      return JsonString("", 0, JsonString::Copied);
+    current()[size_] = 0;
+    return JsonString(current(), size_, JsonString::Copied);
+  }
+
+  // Counts the current string, unless the pool wouldn't store it.
+  // The result is only valid until the next string.
+  JsonString save(bool storedInPool) {
+    JsonString s = str();
+    if (!storedInPool)
+      return s;
+#if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+#  if ARDUINOJSON_STRING_INDEX_SIZE
+    uint32_t hash = index_.hash(adaptString(s));
+    const char* dup = index_.find(buffer_, kept_, adaptString(s), hash);
+    if (!dup && !index_.complete())
+      dup = findString(s);
+#  else
+    const char* dup = findString(s);
+#  endif
+    if (dup)
+      return JsonString(dup, size_, JsonString::Copied);
+#  if ARDUINOJSON_STRING_INDEX_SIZE
+    index_.add(buffer_, kept_, hash);
+#  endif
+    kept_ += size_ + 1;
+#endif
+    bytes_ += size_ + 1;
+    return s;
+  }
+
+ private:
+  char* current() const {
+    return buffer_ + kept_;
+  }
+
+  // Makes room for n bytes after the kept strings
+  bool reserve(size_t n) {
+    if (kept_ + n <= capacity_)
+      return true;
+    size_t capacity = capacity_ ? capacity_ : 32;
+    while (capacity < kept_ + n)
+      capacity *= 2;
+    if (grow(capacity))
+      return true;
+    forgetKeptStrings();
+    if (n <= capacity_ || grow(n))
+      return true;
+    overflowed_ = true;
+    return false;
+  }
+
+  bool grow(size_t capacity) {
+    char* buffer = static_cast<char*>(
+        buffer_ ? allocator_.reallocate(buffer_, capacity)
+                : allocator_.allocate(capacity));
+    if (!buffer)
+      return false;
+    buffer_ = buffer;
+    capacity_ = capacity;
+    return true;
+  }
+
+  // Moves the current string to the beginning of the buffer
+  void forgetKeptStrings() {
+    if (!kept_)
+      return;
+    memmove(buffer_, current(), size_);
+    kept_ = 0;
+#if ARDUINOJSON_STRING_INDEX_SIZE
+    index_.clear();
+#endif
+  }
+
+#if ARDUINOJSON_ENABLE_STRING_DEDUPLICATION
+  // Same as MemoryPool::findString()
+  const char* findString(JsonString str) const {
+    size_t n = str.size();
+    for (char* next = buffer_; next + n < current(); ++next) {
+      if (next[n] == '\0' && memcmp(next, str.c_str(), n) == 0)
+        return next;
+
+      // jump to next terminator
+      while (*next)
+        ++next;
+    }
+    return 0;
+  }
+#endif
+
+  TAllocator allocator_;
+  char* buffer_;
+  size_t capacity_, kept_, size_, bytes_;
+  bool overflowed_;
+#if ARDUINOJSON_STRING_INDEX_SIZE
+  StringIndex<ARDUINOJSON_STRING_INDEX_SIZE> index_;
+#endif
+};
+
+// Stands in for TStringStorage when measuring the capacity of a document.
+// It counts the bytes instead of saving the strings in the memory pool, and
+// never modifies the input, even if TStringStorage is a StringMover.
+template <typename TStringStorage>
+class StringCounter {
+ public:
+  StringCounter(CountedStrings<>* strings) : strings_(strings) {}
+
+  void startString() {
+    strings_->startString();
+  }
+
+  JsonString save() {
+    return strings_->save(CopiesStrings<TStringStorage>::value);
+  }
+
+  void append(const char* s, size_t n) {
+    strings_->append(s, n);
+  }
+
+  void append(char c) {
+    strings_->append(c);
+  }
+
+  bool isValid() const {
+    return !strings_->overflowed();
+  }
+
+  size_t size() const {
+    return strings_->size();
+  }
+
+  JsonString str() const {
+    return strings_->str();
+  }
+
+ private:
+  CountedStrings<>* strings_;
+};
+
+template <typename TStringStorage>
+struct CopiesStrings<StringCounter<TStringStorage>>
+    : CopiesStrings<TStringStorage> {};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
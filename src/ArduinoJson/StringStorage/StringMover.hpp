@@ -7,6 +7,8 @@
 #include <ArduinoJson/Namespace.hpp>
 #include <ArduinoJson/Strings/JsonString.hpp>
 
+#include <string.h>  // memmove
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 class StringMover {
@@ -27,6 +29,13 @@ class StringMover {
     *writePtr_++ = c;
   }
 
+  // The source may overlap the destination because we write behind the
+  // reading position
+  void append(const char* s, size_t n) {
+    memmove(writePtr_, s, n);
+    writePtr_ += n;
+  }
+
   bool isValid() const {
     return true;
   }
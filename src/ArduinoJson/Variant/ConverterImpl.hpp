@@ -143,12 +143,12 @@ struct Converter<const char*> : private detail::VariantAttorney {
 
   static const char* fromJson(JsonVariantConst src) {
     auto data = getData(src);
-    return data ? data->asString().c_str() : 0;
+    return data ? data->asCString() : 0;
   }
 
   static bool checkJson(JsonVariantConst src) {
     auto data = getData(src);
-    return data && data->isString();
+    return data && data->asCString();
   }
 };
 
@@ -284,10 +284,14 @@ inline void convertToJson(const ::Printable& src, JsonVariant dst) {
 
 inline void convertFromJson(JsonVariantConst src, ::String& dst) {
   JsonString str = src.as<JsonString>();
-  if (str)
-    dst = str.c_str();
-  else
+  if (str) {
+    // the string may not be null-terminated
+    dst = "";
+    detail::Writer<::String> writer(dst);
+    writer.write(reinterpret_cast<const uint8_t*>(str.c_str()), str.size());
+  } else {
     serializeJson(src, dst);
+  }
 }
 
 inline bool canConvertFromJson(JsonVariantConst src, const ::String&) {
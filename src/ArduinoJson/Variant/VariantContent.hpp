@@ -17,6 +17,7 @@ enum {
 
   OWNED_VALUE_BIT = 0x01,
   VALUE_IS_NULL = 0,
+  VALUE_IS_RAW_NUMBER = 0x01,  // the text of a number, parsed on demand
   VALUE_IS_LINKED_RAW = 0x02,
   VALUE_IS_OWNED_RAW = 0x03,
   VALUE_IS_LINKED_STRING = 0x04,
@@ -31,9 +32,13 @@ enum {
   VALUE_IS_SIGNED_INTEGER = 0x0A,
   VALUE_IS_FLOAT = 0x0C,
 
+  VALUE_IS_LINKED_SLICE = 0x10,  // a linked string, not null-terminated
+
   COLLECTION_MASK = 0x60,
   VALUE_IS_OBJECT = 0x20,
   VALUE_IS_ARRAY = 0x40,
+  VALUE_IS_LINKED_OBJECT = 0x30,  // a shallow copy, doesn't own the slots
+  VALUE_IS_LINKED_ARRAY = 0x50,   // a shallow copy, doesn't own the slots
 
   OWNED_KEY_BIT = 0x80
 };
@@ -32,13 +32,16 @@ class VariantData {
         return visitor.visitFloat(content_.asFloat);
 
       case VALUE_IS_ARRAY:
+      case VALUE_IS_LINKED_ARRAY:
         return visitor.visitArray(content_.asCollection);
 
       case VALUE_IS_OBJECT:
+      case VALUE_IS_LINKED_OBJECT:
         return visitor.visitObject(content_.asCollection);
 
       case VALUE_IS_LINKED_STRING:
       case VALUE_IS_OWNED_STRING:
+      case VALUE_IS_LINKED_SLICE:
         return visitor.visitString(content_.asString.data,
                                    content_.asString.size);
 
@@ -47,6 +50,9 @@ class VariantData {
         return visitor.visitRawJson(content_.asString.data,
                                     content_.asString.size);
 
+      case VALUE_IS_RAW_NUMBER:
+        return acceptRawNumber(visitor, 0);
+
       case VALUE_IS_SIGNED_INTEGER:
         return visitor.visitSignedInteger(content_.asSignedInteger);
 
@@ -69,6 +75,11 @@ class VariantData {
 
   JsonString asString() const;
 
+  // Returns null if the value is not a null-terminated string
+  const char* asCString() const {
+    return type() == VALUE_IS_LINKED_SLICE ? 0 : asString().c_str();
+  }
+
   bool asBoolean() const;
 
   CollectionData* asArray() {
@@ -83,6 +94,14 @@ class VariantData {
     return isCollection() ? &content_.asCollection : 0;
   }
 
+  // Returns null if the value is not a collection, or if it's a shallow copy,
+  // which shares the slots of another collection
+  const CollectionData* asOwnedCollection() const {
+    return type() == VALUE_IS_ARRAY || type() == VALUE_IS_OBJECT
+               ? &content_.asCollection
+               : 0;
+  }
+
   CollectionData* asObject() {
     return isObject() ? &content_.asCollection : 0;
   }
@@ -114,17 +133,24 @@ class VariantData {
       case VALUE_IS_SIGNED_INTEGER:
         return canConvertNumber<T>(content_.asSignedInteger);
 
+      case VALUE_IS_RAW_NUMBER: {
+        VariantData value;
+        parseRawNumber(value);
+        return value.isInteger<T>();
+      }
+
       default:
         return false;
     }
   }
 
   bool isFloat() const {
-    return (flags_ & NUMBER_BIT) != 0;
+    return (flags_ & NUMBER_BIT) != 0 || type() == VALUE_IS_RAW_NUMBER;
   }
 
   bool isString() const {
-    return type() == VALUE_IS_LINKED_STRING || type() == VALUE_IS_OWNED_STRING;
+    return type() == VALUE_IS_LINKED_STRING ||
+           type() == VALUE_IS_OWNED_STRING || type() == VALUE_IS_LINKED_SLICE;
   }
 
   bool isObject() const {
@@ -184,6 +210,15 @@ class VariantData {
     }
   }
 
+  // Stores the text of a number, which must be valid JSON, null-terminated,
+  // and saved in the pool.
+  void setRawNumber(JsonString text) {
+    ARDUINOJSON_ASSERT(text);
+    setType(VALUE_IS_RAW_NUMBER);
+    content_.asString.data = text.c_str();
+    content_.asString.size = text.size();
+  }
+
   template <typename T>
   typename enable_if<is_unsigned<T>::value>::type setInteger(T value) {
     setType(VALUE_IS_UNSIGNED_INTEGER);
@@ -200,6 +235,14 @@ class VariantData {
     setType(VALUE_IS_NULL);
   }
 
+  // Copies the value, but not the slots of a collection, which remain owned
+  // by the source
+  void shallowCopy(const VariantData& src) {
+    *this = src;
+    if (isCollection())
+      setType(isArray() ? VALUE_IS_LINKED_ARRAY : VALUE_IS_LINKED_OBJECT);
+  }
+
   void setString(JsonString s) {
     ARDUINOJSON_ASSERT(s);
     if (s.isLinked())
@@ -210,6 +253,29 @@ class VariantData {
     content_.asString.size = s.size();
   }
 
+  // Links a string that isn't null-terminated, like a string in the input
+  void setLinkedSlice(const char* data, size_t size) {
+    ARDUINOJSON_ASSERT(data);
+    setType(VALUE_IS_LINKED_SLICE);
+    content_.asString.data = data;
+    content_.asString.size = size;
+  }
+
+  // Copies a string linked by setLinkedSlice() to the pool, so that it's
+  // null-terminated. Returns false if the pool is full; the string remains
+  // linked.
+  bool ownLinkedSlice(MemoryPool* pool) {
+    if (type() != VALUE_IS_LINKED_SLICE)
+      return true;
+    size_t size = content_.asString.size;
+    const char* copy =
+        pool->saveString(adaptString(content_.asString.data, size));
+    if (!copy)
+      return false;
+    setString(JsonString(copy, size, JsonString::Copied));
+    return true;
+  }
+
   CollectionData& toArray() {
     setType(VALUE_IS_ARRAY);
     content_.asCollection.clear();
@@ -226,11 +292,14 @@ class VariantData {
     switch (type()) {
       case VALUE_IS_OWNED_STRING:
       case VALUE_IS_OWNED_RAW:
+      case VALUE_IS_RAW_NUMBER:
         // We always add a zero at the end: the deduplication function uses it
         // to detect the beginning of the next string.
         return content_.asString.size + 1;
       case VALUE_IS_OBJECT:
       case VALUE_IS_ARRAY:
+      case VALUE_IS_LINKED_OBJECT:
+      case VALUE_IS_LINKED_ARRAY:
         return content_.asCollection.memoryUsage();
       default:
         return 0;
@@ -299,6 +368,22 @@ class VariantData {
   }
 
  private:
+  // Passes the text to the visitors that support it, like JsonSerializer, so
+  // the number is written unchanged
+  template <typename TVisitor>
+  auto acceptRawNumber(TVisitor& visitor, int) const
+      -> decltype(visitor.visitRawNumber(0, 0)) {
+    return visitor.visitRawNumber(content_.asString.data,
+                                  content_.asString.size);
+  }
+
+  // Passes the parsed number to the other visitors
+  template <typename TVisitor>
+  typename TVisitor::result_type acceptRawNumber(TVisitor& visitor,
+                                                 long) const;
+
+  void parseRawNumber(VariantData& out) const;
+
   void setType(uint8_t t) {
     flags_ &= OWNED_KEY_BIT;
     flags_ |= t;
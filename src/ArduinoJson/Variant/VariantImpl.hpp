@@ -26,6 +26,7 @@ inline T VariantData::asIntegral() const {
       return convertNumber<T>(content_.asSignedInteger);
     case VALUE_IS_LINKED_STRING:
     case VALUE_IS_OWNED_STRING:
+    case VALUE_IS_RAW_NUMBER:
       return parseNumber<T>(content_.asString.data);
     case VALUE_IS_FLOAT:
       return convertNumber<T>(content_.asFloat);
@@ -43,6 +44,11 @@ inline bool VariantData::asBoolean() const {
       return content_.asUnsignedInteger != 0;
     case VALUE_IS_FLOAT:
       return content_.asFloat != 0;
+    case VALUE_IS_RAW_NUMBER: {
+      VariantData value;
+      parseRawNumber(value);
+      return value.asBoolean();
+    }
     case VALUE_IS_NULL:
       return false;
     default:
@@ -62,6 +68,7 @@ inline T VariantData::asFloat() const {
       return static_cast<T>(content_.asSignedInteger);
     case VALUE_IS_LINKED_STRING:
     case VALUE_IS_OWNED_STRING:
+    case VALUE_IS_RAW_NUMBER:
       return parseNumber<T>(content_.asString.data);
     case VALUE_IS_FLOAT:
       return static_cast<T>(content_.asFloat);
@@ -73,6 +80,7 @@ inline T VariantData::asFloat() const {
 inline JsonString VariantData::asString() const {
   switch (type()) {
     case VALUE_IS_LINKED_STRING:
+    case VALUE_IS_LINKED_SLICE:
       return JsonString(content_.asString.data, content_.asString.size,
                         JsonString::Linked);
     case VALUE_IS_OWNED_STRING:
@@ -86,8 +94,10 @@ inline JsonString VariantData::asString() const {
 inline bool VariantData::copyFrom(const VariantData& src, MemoryPool* pool) {
   switch (src.type()) {
     case VALUE_IS_ARRAY:
+    case VALUE_IS_LINKED_ARRAY:
       return toArray().copyFrom(src.content_.asCollection, pool);
     case VALUE_IS_OBJECT:
+    case VALUE_IS_LINKED_OBJECT:
       return toObject().copyFrom(src.content_.asCollection, pool);
     case VALUE_IS_OWNED_STRING: {
       JsonString value = src.asString();
@@ -97,6 +107,16 @@ inline bool VariantData::copyFrom(const VariantData& src, MemoryPool* pool) {
       return storeOwnedRaw(
           serialized(src.content_.asString.data, src.content_.asString.size),
           pool);
+    case VALUE_IS_RAW_NUMBER: {
+      const char* dup = pool->saveString(
+          adaptString(src.content_.asString.data, src.content_.asString.size));
+      if (!dup) {
+        setNull();
+        return false;
+      }
+      setRawNumber(JsonString(dup, src.content_.asString.size));
+      return true;
+    }
     default:
       setType(src.type());
       content_ = src.content_;
@@ -104,6 +124,18 @@ inline bool VariantData::copyFrom(const VariantData& src, MemoryPool* pool) {
   }
 }
 
+inline void VariantData::parseRawNumber(VariantData& out) const {
+  parseNumber(content_.asString.data, out);
+}
+
+template <typename TVisitor>
+inline typename TVisitor::result_type VariantData::acceptRawNumber(
+    TVisitor& visitor, long) const {
+  VariantData value;
+  parseRawNumber(value);
+  return value.accept(visitor);
+}
+
 template <typename TDerived>
 inline JsonVariant VariantRefBase<TDerived>::add() const {
   return JsonVariant(getPool(),
@@ -117,6 +149,16 @@ VariantRefBase<TDerived>::as() const {
   return Converter<T>::fromJson(getVariant());
 }
 
+template <typename TDerived>
+template <typename T>
+inline typename enable_if<is_same<T, const char*>::value, T>::type
+VariantRefBase<TDerived>::as() const {
+  VariantData* data = getData();
+  if (data)
+    data->ownLinkedSlice(getPool());
+  return Converter<T>::fromJson(getVariantConst());
+}
+
 template <typename TDerived>
 inline JsonVariant VariantRefBase<TDerived>::getVariant() const {
   return JsonVariant(getPool(), getData());
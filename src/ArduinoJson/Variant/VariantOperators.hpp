@@ -43,10 +43,9 @@ struct VariantOperators : VariantOperatorTag {
   // const char* operator|(JsonVariant, const char*)
   friend const char* operator|(const TVariant& variant,
                                const char* defaultValue) {
-    if (variant.template is<const char*>())
-      return variant.template as<const char*>();
-    else
-      return defaultValue;
+    // as<const char*>() returns null if the value is not a string
+    const char* value = variant.template as<const char*>();
+    return value ? value : defaultValue;
   }
   //
   // JsonVariant operator|(JsonVariant, JsonVariant)
@@ -47,9 +47,10 @@ class VariantRefBase : public VariantTag {
   // Casts the value to the specified type.
   // https://arduinojson.org/v6/api/jsonvariant/as/
   template <typename T>
-  FORCE_INLINE
-      typename enable_if<!ConverterNeedsWriteableRef<T>::value, T>::type
-      as() const {
+  FORCE_INLINE typename enable_if<!ConverterNeedsWriteableRef<T>::value &&
+                                      !is_same<T, const char*>::value,
+                                  T>::type
+  as() const {
     return Converter<T>::fromJson(getVariantConst());
   }
 
@@ -59,6 +60,14 @@ class VariantRefBase : public VariantTag {
   FORCE_INLINE typename enable_if<ConverterNeedsWriteableRef<T>::value, T>::type
   as() const;
 
+  // Casts the value to a C string.
+  // A string linked by DeserializationOption::ZeroCopy isn't null-terminated,
+  // so it's copied to the memory pool first; if the pool is full, it returns
+  // null.
+  // https://arduinojson.org/v6/api/jsonvariant/as/
+  template <typename T>
+  typename enable_if<is_same<T, const char*>::value, T>::type as() const;
+
   template <typename T,
             typename = typename enable_if<!is_same<T, TDerived>::value>::type>
   FORCE_INLINE operator T() const {
@@ -109,7 +118,7 @@ class VariantRefBase : public VariantTag {
       return;
     const VariantData* targetData = VariantAttorney::getData(target);
     if (targetData)
-      *data = *targetData;
+      data->shallowCopy(*targetData);
     else
       data->setNull();
   }